@@ -14,6 +14,8 @@
 #include <sys/time.h>
 #include <time.h>
 
+#include "test_asserts.h"
+
 //@note the source should be in utf-8
 
 static bool haveOption(int argc, char **argv, const char *name)
@@ -108,9 +110,6 @@ ulxr::Struct serializeMyStruct(const MyStruct& aMyStruct)
     return myRetVal;
 }
 
-#define TEST_ASSERT(condition) if (!(condition)) { std::cerr << "TEST ASSERTION FAILED at " << __FILE__  << ":" <<__LINE__ << "\n" << #condition << "\n"; throw std::runtime_error("TEST FAILED");}
-#define TEST_ASSERT_EQUALS(actual, expected) if (actual != expected) { std::cerr << "TEST EQUALITY ASSERTION FAILED at " << __FILE__  << ":" <<__LINE__ << "\nActual: " << actual << "\nExpected: " << expected << "\n"; throw std::runtime_error("TEST FAILED");}
-#define TEST_ASSERT_EQUALS_NOPRINT(actual, expected) if (actual != expected) { std::cerr << "TEST EQUALITY ASSERTION FAILED at " << __FILE__  << ":" <<__LINE__ << "\n" << #actual << " != " << #expected << "\n"; throw std::runtime_error("TEST FAILED");}
 
 class TestWorker
 {
@@ -189,11 +188,11 @@ void callEcho(ulxr::Requester& aClient)
     TEST_ASSERT_EQUALS(ulxr::Boolean(myResp.getMember("arg2")).getBoolean(), myBoolArg);
     TEST_ASSERT_EQUALS(ulxr::Double(myResp.getMember("arg3")).getDouble(), myDoubleArg);
     TEST_ASSERT_EQUALS(ulxr::DateTime(myResp.getMember("arg4")).getDateTime(), myDateArg1);
-    //@todo fix&enable this check (use local time)
-    // TEST_ASSERT_EQUALS(ulxr::DateTime(myResp.getMember("arg5")).getDateTime(), "19700101T00:00:00");
+    TEST_ASSERT_EQUALS(ulxr::DateTime(myResp.getMember("arg5")).getTimeT(), myDateArg2);
     TEST_ASSERT_EQUALS(ulxr::RpcString(myResp.getMember("arg6")).getString(), myStrArg);
     TEST_ASSERT_EQUALS(ulxr::Base64(myResp.getMember("arg7")).getString(), myB64Arg);
     TEST_ASSERT_EQUALS_NOPRINT(deserializeIntArray<std::vector<int> >(ulxr::Array(myResp.getMember("arg8"))), myArrayArg);
+    TEST_ASSERT_EQUALS_NOPRINT(ulxr::Array(myResp.getMember("arg8")).getIntVector(), myArrayArg);
     TEST_ASSERT_EQUALS_NOPRINT(deserializeMyStruct(ulxr::Struct(myResp.getMember("arg9"))), myStructArg);
 }
 
@@ -221,6 +220,9 @@ int main(int argc, char **argv)
     bool myConnectToIpv4 = haveOption(argc, argv, "connect-ipv4") || myIpv4Only;
     bool myUseSsl = haveOption(argc, argv, "ssl");
     bool myIsPerformanceTest = haveOption(argc, argv, "performance");
+    bool myKeepAlive = haveOption(argc, argv, "keepalive");
+    bool myNativeParser = haveOption(argc, argv, "native");
+    bool myArena = haveOption(argc, argv, "arena");
 
     const std::string ipv4 = "127.0.0.1";
     const std::string ipv6 = myIpv4Only? "" : "::1";
@@ -255,9 +257,14 @@ int main(int argc, char **argv)
 
         mySvrConn->setTcpNoDelay(true);
         mySvrProto.reset(new ulxr::HttpProtocol(mySvrConn.get()));
+        mySvrProto->setPersistent(myKeepAlive);
+        mySvrProto->setKeepAliveLimits(1, 50); // idle seconds, requests per connection
 
         unsigned int myNumProc = 1;
         ulxr::MultiProcessRpcServer server(mySvrProto.get(), myNumProc);
+        server.useNativeParser(myNativeParser);
+        server.useArena(myArena);
+        TEST_ASSERT_EQUALS(server.isArenaUsed(), myArena);
 
         TestWorker worker;
 
@@ -282,12 +289,22 @@ int main(int argc, char **argv)
             myClientConn.reset(new ulxr::TcpIpConnection (myConnectToIpv4 ? ipv4 : ipv6, port));
         myClientConn->setTcpNoDelay(true);
         ulxr::HttpProtocol myClientProto(myClientConn.get());
+        myClientProto.setPersistent(myKeepAlive);
         ulxr::Requester myClient(&myClientProto);
+        myClient.useNativeParser(myNativeParser);
 
         for (size_t iCall = 0; iCall < myNumCalls; ++iCall)
         {
             callEcho(myClient);
         }
+        if (myKeepAlive && !myIsPerformanceTest)
+        {
+            TEST_ASSERT(myClientProto.isKeepAlive());
+            TEST_ASSERT(myClientProto.isOpen());
+            mysleep(1500); // the server closes the idle connection meanwhile
+            callEcho(myClient);
+            TEST_ASSERT(myClientProto.isOpen());
+        }
         if (myIsPerformanceTest)
         {
             gettimeofday(&endTick, NULL);
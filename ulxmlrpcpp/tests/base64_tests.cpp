@@ -0,0 +1,148 @@
+#include <ulxmlrpcpp/ulxmlrpcpp.h>
+#include <ulxmlrpcpp/ulxr_base64.h>
+#include <ulxmlrpcpp/ulxr_except.h>
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <openssl/bio.h>
+#include <openssl/buffer.h>
+#include <openssl/evp.h>
+
+#include "test_asserts.h"
+
+// the former implementation of toBase64() with an OpenSSL BIO
+std::string opensslEncode(const std::vector<unsigned char> &data, bool singleLine)
+{
+    if (data.empty())
+        return "";
+    BIO *bio = BIO_push(BIO_new(BIO_f_base64()), BIO_new(BIO_s_mem()));
+    if (singleLine)
+        BIO_set_flags(bio, BIO_FLAGS_BASE64_NO_NL);
+    TEST_ASSERT(BIO_write(bio, data.data(), (int)data.size()) == (int)data.size());
+    BIO_flush(bio);
+    BUF_MEM *mem;
+    BIO_get_mem_ptr(bio, &mem);
+    std::string text(mem->data, mem->length);
+    BIO_free_all(bio);
+    if (!text.empty() && text[text.length() - 1] == '\n')
+        text.erase(text.length() - 1);
+    return text;
+}
+
+// the former implementation of fromBase64() with an OpenSSL BIO
+std::vector<unsigned char> opensslDecode(std::string text, bool singleLine)
+{
+    if (text.empty() || text[text.length() - 1] != '\n')
+        text += '\n';
+    BIO *bio = BIO_push(BIO_new(BIO_f_base64()), BIO_new_mem_buf(&text[0], (int)text.length()));
+    if (singleLine)
+        BIO_set_flags(bio, BIO_FLAGS_BASE64_NO_NL);
+    std::vector<unsigned char> data;
+    unsigned char buffer[128];
+    int got;
+    while ((got = BIO_read(bio, buffer, sizeof(buffer))) > 0)
+        data.insert(data.end(), buffer, buffer + got);
+    BIO_free_all(bio);
+    return data;
+}
+
+// wraps the text into lines of 76 characters ending with CRLF as in MIME
+std::string mimeLines(const std::string &text)
+{
+    std::string lines;
+    for (std::size_t pos = 0; pos < text.length(); pos += 76)
+        lines += text.substr(pos, 76) + "\r\n";
+    return lines;
+}
+
+std::vector<unsigned char> bytes(const std::string &str)
+{
+    return std::vector<unsigned char>(str.begin(), str.end());
+}
+
+void testKernel(ulxr::Base64Kernel kernel)
+{
+    std::vector<unsigned char> data;
+    for (std::size_t len = 0; len <= 1100; len += (len < 300 ? 1 : 97))
+    {
+        data.resize(len);
+        for (std::size_t i = 0; i < len; ++i)
+            data[i] = std::rand() % 256;
+
+        // encoding gives exactly what OpenSSL gave
+        for (bool singleLine : {false, true})
+        {
+            const std::string text = ulxr::toBase64(data, singleLine);
+            TEST_ASSERT_EQUALS(text, opensslEncode(data, singleLine));
+            TEST_ASSERT_EQUALS_NOPRINT(ulxr::fromBase64(text, singleLine), data);
+            TEST_ASSERT_EQUALS_NOPRINT(ulxr::fromBase64(text + "\n", singleLine), data);
+        }
+
+        // wrapped text from other encoders
+        const std::string lines = mimeLines(ulxr::toBase64(data, true));
+        TEST_ASSERT_EQUALS_NOPRINT(opensslDecode(lines, false), data);
+        TEST_ASSERT_EQUALS_NOPRINT(ulxr::fromBase64(lines, false), data);
+
+        // any character which is not base64 or white space makes the text invalid
+        if (len > 0)
+        {
+            const std::string text = ulxr::toBase64(data, false);
+            for (const char bad : {'*', '-', '_', '\0', '\x80'})
+            {
+                std::string corrupt = text;
+                corrupt[std::rand() % (corrupt.length() - (len % 3 == 0 ? 0 : 3 - len % 3))] = bad;
+                TEST_ASSERT(ulxr::fromBase64(corrupt, false).empty());
+                TEST_ASSERT(ulxr::fromBase64(corrupt, true).empty());
+            }
+
+            // in single line mode only the end may be white space
+            TEST_ASSERT(ulxr::fromBase64(lines, true).empty() == (len > 57));
+        }
+    }
+
+    // white space in multi line mode
+    TEST_ASSERT_EQUALS_NOPRINT(ulxr::fromBase64("QU\r\nJD\t\n Q Q = =\n", false), bytes("ABCA"));
+    TEST_ASSERT_EQUALS_NOPRINT(ulxr::fromBase64("QUJD\r\n", true), bytes("ABC"));
+
+    // single line mode ignores an incomplete last group and anything after the padding
+    TEST_ASSERT_EQUALS_NOPRINT(ulxr::fromBase64("QUJDQQ", true), bytes("ABC"));
+    TEST_ASSERT_EQUALS_NOPRINT(opensslDecode("QUJDQQ", true), bytes("ABC"));
+    // where OpenSSL decoded the padding as zero bytes
+    TEST_ASSERT_EQUALS_NOPRINT(ulxr::fromBase64("QQ==QUJD", true), bytes("A"));
+    std::cout << "Kernel " << kernel << " checked\n";
+}
+
+////////////////////////////////////////////////////////////////////////
+int main()
+{
+    const ulxr::Base64Kernel defaultKernel = ulxr::getBase64Kernel();
+    try
+    {
+        std::srand(1);
+        for (unsigned k = ulxr::Base64Scalar; k <= ulxr::Base64Avx2; ++k)
+        {
+            if (!ulxr::setBase64Kernel(ulxr::Base64Kernel(k)))
+            {
+                std::cout << "Kernel " << k << " is not supported by the cpu\n";
+                continue;
+            }
+            testKernel(ulxr::Base64Kernel(k));
+        }
+        ulxr::setBase64Kernel(defaultKernel);
+    }
+    catch(ulxr::Exception &ex)
+    {
+        std::cerr << "Error occurred: " << ex.why() << std::endl;
+        return 1;
+    }
+    catch(std::exception &ex)
+    {
+        std::cerr << "Error occurred: " << ex.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
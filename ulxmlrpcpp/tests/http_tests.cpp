@@ -0,0 +1,325 @@
+#include <ulxmlrpcpp/ulxmlrpcpp.h>
+#include <ulxmlrpcpp/ulxr_http_protocol.h>
+#include <ulxmlrpcpp/ulxr_except.h>
+#include <ulxmlrpcpp/ulxr_call.h>
+#include <ulxmlrpcpp/ulxr_response.h>
+#include <ulxmlrpcpp/ulxr_signature.h>
+#include <ulxmlrpcpp/ulxr_requester.h>
+#include <ulxmlrpcpp/ulxr_mprpc_server.h>
+#include <ulxmlrpcpp/ulxr_tcpip_connection.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "test_asserts.h"
+
+// exposes the length which the header announced
+class TestHttpProtocol : public ulxr::HttpProtocol
+{
+public:
+
+    TestHttpProtocol()
+        : ulxr::HttpProtocol(0, "localhost", 80)
+    {}
+
+    using ulxr::HttpProtocol::getContentLength;
+};
+
+// feeds a request header and returns the announced length or the status code of the rejection as negative number
+long readContentLength(const std::string &fields)
+{
+    TestHttpProtocol http;
+    std::string header = "POST /RPC2 HTTP/1.1\r\n" + fields + "\r\n";
+    char *data = &header[0];
+    long len = header.length();
+    try
+    {
+        TEST_ASSERT_EQUALS(http.connectionMachine(data, len), ulxr::Protocol::ConnBody);
+    }
+    catch (ulxr::ConnectionException &ex)
+    {
+        TEST_ASSERT(!http.isKeepAlive());
+        return -ex.getStatusCode();
+    }
+    return http.getContentLength();
+}
+
+void testContentLength()
+{
+    TEST_ASSERT_EQUALS(readContentLength("Content-Length: 12\r\n"), 12);
+    TEST_ASSERT_EQUALS(readContentLength("content-length:0\r\n"), 0);
+    TEST_ASSERT_EQUALS(readContentLength("Content-Length:   7  \r\n"), 7);
+
+    // the value ends with its line
+    TEST_ASSERT_EQUALS(readContentLength("Content-Length: 12\r\n3x: y\r\n"), 12);
+    TEST_ASSERT_EQUALS(readContentLength("Content-Length:\r\n8x: y\r\n"), -400);
+    TEST_ASSERT_EQUALS(readContentLength("Content-Length: \r\n"), -400);
+
+    // only plain digits
+    TEST_ASSERT_EQUALS(readContentLength("Content-Length: -5\r\n"), -400);
+    TEST_ASSERT_EQUALS(readContentLength("Content-Length: +5\r\n"), -400);
+    TEST_ASSERT_EQUALS(readContentLength("Content-Length: 12abc\r\n"), -400);
+    TEST_ASSERT_EQUALS(readContentLength("Content-Length: 1 2\r\n"), -400);
+    TEST_ASSERT_EQUALS(readContentLength("Content-Length: 0x10\r\n"), -400);
+    TEST_ASSERT_EQUALS(readContentLength("Content-Length: 99999999999999999999999\r\n"), -400);
+
+    // repeated fields must agree
+    TEST_ASSERT_EQUALS(readContentLength("Content-Length: 12\r\nContent-Length: 12\r\n"), 12);
+    TEST_ASSERT_EQUALS(readContentLength("Content-Length: 12\r\nContent-Length: 13\r\n"), -400);
+    TEST_ASSERT_EQUALS(readContentLength("Content-Length: 12\r\nContent-Length: x\r\n"), -400);
+}
+
+// plain sockets play the peer to see the connections as they are
+int listenSocket(unsigned &port)
+{
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t len = sizeof(addr);
+    TEST_ASSERT(bind(fd, (sockaddr*)&addr, len) == 0 && listen(fd, 4) == 0);
+    TEST_ASSERT(getsockname(fd, (sockaddr*)&addr, &len) == 0);
+    port = ntohs(addr.sin_port);
+    return fd;
+}
+
+int connectSocket(unsigned port)
+{
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(port);
+    TEST_ASSERT(connect(fd, (sockaddr*)&addr, sizeof(addr)) == 0);
+    return fd;
+}
+
+void writeAll(int fd, const std::string &data)
+{
+    for (std::size_t pos = 0; pos < data.length(); )
+    {
+        ssize_t written = write(fd, data.data() + pos, data.length() - pos);
+        if (written <= 0)
+            return;
+        pos += written;
+    }
+}
+
+// reads a header and the body announced by its Content-Length, empty at the end of the connection
+std::string readMessage(int fd)
+{
+    std::string msg;
+    std::size_t total = std::string::npos;
+    char buffer[4096];
+    while (msg.length() != total)
+    {
+        pollfd pfd = { fd, POLLIN, 0 };
+        if (poll(&pfd, 1, 5000) != 1)
+            return msg;
+
+        ssize_t got = read(fd, buffer, sizeof(buffer));
+        if (got <= 0)
+            return msg;
+
+        msg.append(buffer, got);
+        const std::size_t header_end = msg.find("\r\n\r\n");
+        if (total == std::string::npos && header_end != std::string::npos)
+        {
+            std::string header = msg.substr(0, header_end);
+            ulxr::makeLower(header);
+            const std::size_t field = header.find("content-length:");
+            total = header_end + 4 + (field == std::string::npos ? 0 : std::atol(header.c_str() + field + 15));
+        }
+    }
+    return msg;
+}
+
+bool peerClosed(int fd)
+{
+    char c;
+    pollfd pfd = { fd, POLLIN, 0 };
+    return poll(&pfd, 1, 5000) == 1 && read(fd, &c, 1) == 0;
+}
+
+bool contains(const std::string &msg, const std::string &part)
+{
+    return msg.find(part) != std::string::npos;
+}
+
+std::string firstLine(const std::string &msg)
+{
+    return msg.substr(0, msg.find("\r\n"));
+}
+
+std::string answerResponse(bool keepAlive)
+{
+    const std::string body = ulxr::MethodResponse(ulxr::Integer(42)).getXml(0);
+    return std::string("HTTP/1.1 200 OK\r\n")
+           + (keepAlive ? "Connection: Keep-Alive\r\nKeep-Alive: timeout=5\r\n" : "Connection: close\r\n")
+           + "Content-Type: text/xml\r\nContent-Length: " + ulxr::toString(body.length()) + "\r\n\r\n" + body;
+}
+
+int callAnswer(ulxr::Requester &client)
+{
+    return ulxr::Integer(client.call(ulxr::MethodCall("answer"), "/RPC2").getResult()).getInteger();
+}
+
+void testClientReconnects()
+{
+    unsigned port = 0;
+    int listener = listenSocket(port);
+    std::string requests[4];
+    std::atomic<bool> idle_closed(false);
+    std::thread server([&]()
+    {
+        int fd = accept(listener, 0, 0);
+        requests[0] = readMessage(fd);
+        writeAll(fd, answerResponse(true));
+        close(fd);   // an idle connection is closed
+        idle_closed = true;
+
+        fd = accept(listener, 0, 0);
+        requests[1] = readMessage(fd);
+        writeAll(fd, answerResponse(true));
+        requests[2] = readMessage(fd);
+        close(fd);   // closed while the next request arrives
+
+        fd = accept(listener, 0, 0);
+        requests[3] = readMessage(fd);
+        writeAll(fd, answerResponse(false));
+        peerClosed(fd);
+        close(fd);
+    });
+
+    {
+        ulxr::TcpIpConnection conn("127.0.0.1", port);
+        ulxr::HttpProtocol proto(&conn);
+        proto.setPersistent(true);
+        ulxr::Requester client(&proto);
+
+        TEST_ASSERT_EQUALS(callAnswer(client), 42);
+        TEST_ASSERT(proto.isOpen() && proto.isKeepAlive());
+        while (!idle_closed)
+            usleep(1000);
+
+        // the closed pooled connection is noticed before sending
+        TEST_ASSERT_EQUALS(callAnswer(client), 42);
+        TEST_ASSERT(proto.isOpen() && proto.isKeepAlive());
+
+        // the request is sent again over a new connection
+        TEST_ASSERT_EQUALS(callAnswer(client), 42);
+        TEST_ASSERT(!proto.isOpen() && !proto.isKeepAlive());
+    }
+    server.join();
+    close(listener);
+
+    // HTTP/1.0 keeps the server from sending a chunked body
+    for (const std::string &request : requests)
+    {
+        const std::string line = firstLine(request);
+        TEST_ASSERT(line.compare(0, 5, "POST ") == 0);
+        TEST_ASSERT(line.compare(line.length() - 9, 9, " HTTP/1.0") == 0);
+        TEST_ASSERT(contains(request, "\r\nConnection: Keep-Alive\r\n"));
+    }
+}
+
+ulxr::MethodResponse answer(const ulxr::MethodCall &)
+{
+    return ulxr::MethodResponse(ulxr::Integer(42));
+}
+
+std::string callRequest(const std::string &body, std::size_t len)
+{
+    return "POST /RPC2 HTTP/1.0\r\nConnection: Keep-Alive\r\nContent-Type: text/xml\r\n"
+           "Content-Length: " + ulxr::toString(len) + "\r\n\r\n" + body;
+}
+
+void testServerClosesConnections()
+{
+    const unsigned port = 32001;
+    ulxr::IP ip;
+    ip.ipv4 = "127.0.0.1";
+    ulxr::TcpIpConnection conn(ip, port);
+    ulxr::HttpProtocol proto(&conn);
+    proto.setPersistent(true);
+    proto.setKeepAliveLimits(5, 2); // idle seconds, requests per connection
+
+    ulxr::MultiProcessRpcServer server(&proto, 1);
+    server.addMethod(&answer, ulxr::Signature(ulxr::Integer()), "answer", ulxr::Signature());
+    server.start();
+    usleep(500 * 1000); // wait for the service to start
+
+    const std::string call = ulxr::MethodCall("answer").getXml(0);
+
+    // the second request reaches the limit of Keep-Alive: max
+    int fd = connectSocket(port);
+    writeAll(fd, callRequest(call, call.length()));
+    std::string response = readMessage(fd);
+    TEST_ASSERT_EQUALS(firstLine(response), "HTTP/1.1 200 OK");
+    TEST_ASSERT(contains(response, "\r\nConnection: Keep-Alive\r\n"));
+    TEST_ASSERT(contains(response, "\r\nKeep-Alive: timeout=5, max=1\r\n"));
+    TEST_ASSERT(contains(response, "42"));
+
+    writeAll(fd, callRequest(call, call.length()));
+    response = readMessage(fd);
+    TEST_ASSERT_EQUALS(firstLine(response), "HTTP/1.0 200 OK");
+    TEST_ASSERT(contains(response, "\r\nConnection: Close\r\n"));
+    TEST_ASSERT(contains(response, "42"));
+    TEST_ASSERT(peerClosed(fd));
+    close(fd);
+
+    // a fault before the whole body has been read leaves the rest of it on the connection
+    fd = connectSocket(port);
+    writeAll(fd, callRequest("<methodCall></x>", 1000));
+    response = readMessage(fd);
+    TEST_ASSERT(contains(response, "\r\nConnection: Close\r\n"));
+    TEST_ASSERT(contains(response, "faultCode"));
+    TEST_ASSERT(peerClosed(fd));
+    close(fd);
+
+    // a persistent client follows the limit
+    ulxr::TcpIpConnection client_conn("127.0.0.1", port);
+    ulxr::HttpProtocol client_proto(&client_conn);
+    client_proto.setPersistent(true);
+    ulxr::Requester client(&client_proto);
+    TEST_ASSERT_EQUALS(callAnswer(client), 42);
+    TEST_ASSERT(client_proto.isOpen());
+    TEST_ASSERT_EQUALS(callAnswer(client), 42);
+    TEST_ASSERT(!client_proto.isOpen());
+    TEST_ASSERT_EQUALS(callAnswer(client), 42);
+    TEST_ASSERT(client_proto.isOpen());
+}
+
+////////////////////////////////////////////////////////////////////////
+int main()
+{
+    try
+    {
+        testContentLength();
+        testClientReconnects();
+        testServerClosesConnections();
+    }
+    catch(ulxr::Exception &ex)
+    {
+        std::cerr << "Error occurred: " << ex.why() << std::endl;
+        return 1;
+    }
+    catch(std::exception &ex)
+    {
+        std::cerr << "Error occurred: " << ex.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,309 @@
+#include <ulxmlrpcpp/ulxmlrpcpp.h>
+#include <ulxmlrpcpp/ulxr_callparse.h>
+#include <ulxmlrpcpp/ulxr_valueparse_base.h>
+#include <ulxmlrpcpp/ulxr_call.h>
+#include <ulxmlrpcpp/ulxr_value.h>
+#include <ulxmlrpcpp/ulxr_except.h>
+
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include "test_asserts.h"
+
+// parses a call in pieces of random size up to maxPiece, 0 feeds it at once;
+// returns the call as canonical xml or "error"
+std::string parseCall(const std::string &xml, bool native, int maxPiece, std::string *firstParam = 0)
+{
+    try
+    {
+        ulxr::MethodCallParser parser;
+        parser.useNativeParser(native);
+        bool ok = true;
+        if (maxPiece == 0)
+            ok = parser.parse(xml.data(), xml.length(), true);
+
+        else
+        {
+            std::size_t pos = 0;
+            do
+            {
+                std::size_t len = std::min<std::size_t>(1 + std::rand() % maxPiece, xml.length() - pos);
+                ok = parser.parse(xml.data() + pos, len, pos + len == xml.length());
+                pos += len;
+            }
+            while (ok && pos < xml.length());
+        }
+
+        if (!ok || !parser.isComplete())
+            return "error";
+
+        ulxr::MethodCall call = parser.getMethodCall();
+        if (firstParam != 0 && call.numParams() > 0)
+            *firstParam = ulxr::RpcString(call.getParam(0)).getString();
+        return call.getXml(0);
+    }
+    catch (ulxr::Exception &)
+    {
+        return "error";
+    }
+}
+
+// the native parser must give the same result as expat for every piece size
+std::string compareParsers(const std::string &xml)
+{
+    const std::string expected = parseCall(xml, false, 0);
+    for (int maxPiece : {0, 1, 2, 7, 64})
+        for (int round = 0; round < 4; ++round)
+        {
+            std::string actual = parseCall(xml, true, maxPiece);
+            if (actual != expected)
+                std::cerr << "Piece size up to " << maxPiece << ": " << xml << "\n";
+            TEST_ASSERT_EQUALS(actual, expected);
+            if (maxPiece == 0)
+                break;
+        }
+    return expected;
+}
+
+std::string callWithString(const std::string &content)
+{
+    return "<methodCall><methodName>m</methodName><params><param><value><string>"
+           + content + "</string></value></param></params></methodCall>";
+}
+
+std::string nativeString(const std::string &content, int maxPiece)
+{
+    std::string str;
+    TEST_ASSERT(parseCall(callWithString(content), true, maxPiece, &str) != "error");
+    return str;
+}
+
+void testEntities()
+{
+    TEST_ASSERT(compareParsers(callWithString("&lt;&gt;&amp;&apos;&quot;&#65;&#x42;&#xe4;&#x20AC;")) != "error");
+    TEST_ASSERT_EQUALS(nativeString("a&lt;b&#x42;&#67;", 1), "a<bBC");
+    TEST_ASSERT_EQUALS(compareParsers(callWithString("&foo;")), "error");
+    TEST_ASSERT_EQUALS(compareParsers(callWithString("&#0;")), "error");
+    TEST_ASSERT_EQUALS(compareParsers(callWithString("&amp")), "error");
+}
+
+void testCData()
+{
+    TEST_ASSERT(compareParsers(callWithString("<![CDATA[<x>&amp;]]]]>")) != "error");
+    TEST_ASSERT(compareParsers(callWithString("a<![CDATA[]]>b")) != "error");
+    TEST_ASSERT_EQUALS(nativeString("<![CDATA[<x>&amp;]]>", 1), "<x>&amp;");
+    TEST_ASSERT_EQUALS(compareParsers("<![CDATA[x]]>" + callWithString("a")), "error");
+}
+
+void testLineEnds()
+{
+    for (const char *content : {"a\r\nb", "a\rb", "a\r\r\nb\n\r", "\r", "\r\n\r\n", "a\r&#10;b", "a\r<![CDATA[\nb\r\n]]>\n"})
+    {
+        TEST_ASSERT(compareParsers(callWithString(content)) != "error");
+        TEST_ASSERT(nativeString(content, 1).find('\r') == std::string::npos);
+    }
+
+    for (int maxPiece : {0, 1, 3})
+    {
+        TEST_ASSERT_EQUALS(nativeString("a\r\nb\rc\r", maxPiece), "a\nb\nc\n");
+        TEST_ASSERT_EQUALS(nativeString("<![CDATA[a\r\nb\rc]]>", maxPiece), "a\nb\nc");
+        TEST_ASSERT_EQUALS(nativeString("a&#13;\nb", maxPiece), "a\r\nb");
+    }
+}
+
+void testCDataEnd()
+{
+    TEST_ASSERT_EQUALS(compareParsers(callWithString("a]]>b")), "error");
+    TEST_ASSERT_EQUALS(compareParsers(callWithString("]]>")), "error");
+    TEST_ASSERT_EQUALS(compareParsers(callWithString("]]]]>")), "error");
+    TEST_ASSERT(compareParsers(callWithString("a]]b]>c]")) != "error");
+    TEST_ASSERT(compareParsers(callWithString("]]&gt;")) != "error");
+    TEST_ASSERT_EQUALS(nativeString("a]]", 1), "a]]");
+}
+
+void testAttributes()
+{
+    TEST_ASSERT(compareParsers("<methodCall a='1' b=\"2\"><methodName>m</methodName></methodCall>") != "error");
+    TEST_ASSERT_EQUALS(compareParsers("<methodCall a='1' a='2'><methodName>m</methodName></methodCall>"), "error");
+    TEST_ASSERT_EQUALS(compareParsers("<methodCall a='1' b='2' a='1'><methodName>m</methodName></methodCall>"), "error");
+    TEST_ASSERT_EQUALS(compareParsers("<methodCall><methodName x = '1' x='1'>m</methodName></methodCall>"), "error");
+    TEST_ASSERT(compareParsers("<methodCall ab='1' a='2' b='3'><methodName>m</methodName></methodCall>") != "error");
+}
+
+void testDocType()
+{
+    const std::string doctype = "<!DOCTYPE methodCall [<!ENTITY a 'b'>]><methodCall><methodName>&a;</methodName></methodCall>";
+    TEST_ASSERT_EQUALS(parseCall(doctype, true, 0), "error");
+    TEST_ASSERT_EQUALS(parseCall(doctype, true, 1), "error");
+    TEST_ASSERT_EQUALS(parseCall("<!DOCTYPE methodCall><methodCall><methodName>m</methodName></methodCall>", true, 0), "error");
+}
+
+void testSplitDocuments()
+{
+    ulxr::Struct st;
+    st.addMember("alpha", ulxr::Integer(1));
+    st.addMember("a_long_member_name", ulxr::RpcString("text & <stuff> \"q\" 'a' \xc3\xa4\xe2\x82\xac"));
+    ulxr::Array arr;
+    arr << ulxr::Double(1.5) << ulxr::Boolean(true) << st << ulxr::Base64("xyz")
+        << ulxr::DateTime("20260101T10:00:00") << ulxr::Array() << ulxr::Struct();
+    ulxr::MethodCall call("m.name");
+    call.addParam(arr).addParam(st).addParam(ulxr::Integer(5));
+
+    const std::string docs[] =
+    {
+        call.getXml(0),
+        call.getXml(2),
+        "\xEF\xBB\xBF<?xml version='1.0' encoding='UTF-8'?>\r\n<!-- c -->\r\n<methodCall a=\"1\" b = '>' >"
+        "<methodName>x</methodName><params><param><value/></param>"
+        "<param><value><i4>  7 </i4></value></param></params><?pi data?></methodCall>\n"
+    };
+
+    for (const std::string &doc : docs)
+    {
+        TEST_ASSERT(compareParsers(doc) != "error");
+
+        // every cut off document and every single corrupted byte
+        static const char replacements[] = "<>/x &;'\"]-!?=\r\x01\x80\xC3\xFF";
+        for (std::size_t cut = 0; cut < doc.length(); ++cut)
+        {
+            const std::string cut_doc = compareParsers(doc.substr(0, cut));
+            if (cut <= doc.rfind('>'))
+                TEST_ASSERT_EQUALS(cut_doc, "error");
+            std::string corrupt = doc;
+            corrupt[cut] = replacements[std::rand() % (sizeof(replacements) - 1)];
+            compareParsers(corrupt);
+        }
+    }
+}
+
+void testDepthLimit()
+{
+    std::string open, close;
+    for (int i = 0; i < (ULXR_MAX_XML_DEPTH - 3) / 3; ++i)   // methodCall, params and param come first
+    {
+        open += "<value><array><data>";
+        close = "</data></array></value>" + close;
+    }
+    const std::string call = "<methodCall><methodName>m</methodName><params><param>";
+    const std::string call_end = "</param></params></methodCall>";
+
+    // up to the limit both parsers agree
+    TEST_ASSERT(compareParsers(call + open + close + call_end) != "error");
+
+    // beyond it the native parser gives up while expat goes on
+    open += "<value><array><data>";
+    close = "</data></array></value>" + close;
+    TEST_ASSERT(parseCall(call + open + close + call_end, false, 0) != "error");
+    TEST_ASSERT_EQUALS(parseCall(call + open + close + call_end, true, 0), "error");
+    TEST_ASSERT_EQUALS(parseCall(call + open + close + call_end, true, 64), "error");
+}
+
+typedef ulxr::ValueParserBase VPB;
+
+bool isTagName(const std::string &name)
+{
+    for (unsigned t = VPB::eTagUnknown + 1; t < VPB::eTagLast; ++t)
+        if (name == VPB::getTagName(VPB::Tag(t)))
+            return true;
+    return false;
+}
+
+void testTags()
+{
+    TEST_ASSERT_EQUALS(VPB::getTag(""), VPB::eTagUnknown);
+    TEST_ASSERT_EQUALS(VPB::getTag(VPB::getTagName(VPB::eTagUnknown)), VPB::eTagUnknown);
+
+    for (unsigned t = VPB::eTagUnknown + 1; t < VPB::eTagLast; ++t)
+    {
+        const VPB::Tag tag = VPB::Tag(t);
+        const std::string name = VPB::getTagName(tag);
+        TEST_ASSERT_EQUALS(VPB::getTag(name.c_str()), tag);
+
+        // wrong case
+        std::string upper = name;
+        for (char &c : upper)
+            c = std::toupper(static_cast<unsigned char>(c));
+        TEST_ASSERT_EQUALS(VPB::getTag(upper.c_str()), VPB::eTagUnknown);
+        std::string first_upper = name;
+        first_upper[0] = std::toupper(static_cast<unsigned char>(first_upper[0]));
+        TEST_ASSERT_EQUALS(VPB::getTag(first_upper.c_str()), VPB::eTagUnknown);
+
+        // prefixes and extensions
+        for (std::size_t len = 1; len < name.length(); ++len)
+            if (!isTagName(name.substr(0, len)))
+                TEST_ASSERT_EQUALS(VPB::getTag(name.substr(0, len).c_str()), VPB::eTagUnknown);
+        if (!isTagName(name + "s"))
+            TEST_ASSERT_EQUALS(VPB::getTag((name + "s").c_str()), VPB::eTagUnknown);
+        TEST_ASSERT_EQUALS(VPB::getTag((name + " ").c_str()), VPB::eTagUnknown);
+        TEST_ASSERT_EQUALS(VPB::getTag(("x:" + name).c_str()), VPB::eTagUnknown);
+
+        // the same length, first and last character hit the same slot
+        if (name.length() > 2)
+        {
+            std::string collision = name;
+            for (std::size_t i = 1; i + 1 < collision.length(); ++i)
+                collision[i] = collision[i] == 'x' ? 'y' : 'x';
+            TEST_ASSERT_EQUALS(VPB::getTag(collision.c_str()), VPB::eTagUnknown);
+
+            collision = name;
+            collision[collision.length() / 2] ^= 0x20;
+            TEST_ASSERT_EQUALS(VPB::getTag(collision.c_str()), VPB::eTagUnknown);
+        }
+    }
+    TEST_ASSERT_EQUALS(VPB::getTag("valve"), VPB::eTagUnknown);
+    TEST_ASSERT_EQUALS(VPB::getTag("sprint"), VPB::eTagUnknown);
+    TEST_ASSERT_EQUALS(VPB::getTag("i8"), VPB::eTagUnknown);
+
+    // every slot of the hash is reached by names which are no tags
+    static const char chars[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789._-:";
+    for (std::size_t len = 1; len <= 20; ++len)
+        for (const char *first = chars; *first != 0; ++first)
+            for (const char *last = chars; *last != 0; ++last)
+            {
+                std::string name(len, 'a');
+                name[0] = *first;
+                name[len - 1] = *last;
+                const VPB::Tag tag = VPB::getTag(name.c_str());
+                if (isTagName(name))
+                {
+                    TEST_ASSERT_EQUALS(VPB::getTagName(tag), name);
+                }
+                else
+                {
+                    TEST_ASSERT_EQUALS(tag, VPB::eTagUnknown);
+                }
+            }
+}
+
+////////////////////////////////////////////////////////////////////////
+int main()
+{
+    try
+    {
+        std::srand(1);
+        testTags();
+        testEntities();
+        testCData();
+        testLineEnds();
+        testCDataEnd();
+        testAttributes();
+        testDocType();
+        testSplitDocuments();
+        testDepthLimit();
+    }
+    catch(ulxr::Exception &ex)
+    {
+        std::cerr << "Error occurred: " << ex.why() << std::endl;
+        return 1;
+    }
+    catch(std::exception &ex)
+    {
+        std::cerr << "Error occurred: " << ex.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
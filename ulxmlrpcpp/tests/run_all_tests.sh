@@ -11,6 +11,16 @@ function runTest()
     sleep 0.5 # to make sure all processes are stopped so we do not get "Address already in use"
 }
 
+function runUnitTest()
+{
+    echo "--- Running: $1"
+    if ./$1 ; then
+        succeeded=$(($succeeded + 1))
+    else
+        failed=$(($failed + 1))
+    fi
+}
+
 function hasIpv6()
 {
     if ip addr show | grep -q "inet6 ::1"
@@ -26,6 +36,11 @@ failed=0
 
 echo "*** Running tests:"
 
+runUnitTest base64_tests
+runUnitTest http_tests
+runUnitTest parser_tests
+runUnitTest value_tests
+
 if hasIpv6 ; then
     runTest
     runTest "connect-ipv4"
@@ -33,11 +48,27 @@ if hasIpv6 ; then
     runTest "ssl connect-ipv4"
     runTest "performance"
     runTest "performance ssl"
+    runTest "keepalive"
+    runTest "ssl keepalive"
+    runTest "performance keepalive"
+    runTest "performance ssl keepalive"
+    runTest "native"
+    runTest "performance native"
+    runTest "arena"
+    runTest "performance native arena"
 else
     runTest "ipv4-only"
     runTest "ssl ipv4-only"
     runTest "performance ipv4-only"
     runTest "performance ssl ipv4-only"
+    runTest "keepalive ipv4-only"
+    runTest "ssl keepalive ipv4-only"
+    runTest "performance keepalive ipv4-only"
+    runTest "performance ssl keepalive ipv4-only"
+    runTest "native ipv4-only"
+    runTest "performance native ipv4-only"
+    runTest "arena ipv4-only"
+    runTest "performance native arena ipv4-only"
 fi
 
 
@@ -0,0 +1,11 @@
+#ifndef ULXR_TEST_ASSERTS_H
+#define ULXR_TEST_ASSERTS_H
+
+#include <iostream>
+#include <stdexcept>
+
+#define TEST_ASSERT(condition) if (!(condition)) { std::cerr << "TEST ASSERTION FAILED at " << __FILE__  << ":" <<__LINE__ << "\n" << #condition << "\n"; throw std::runtime_error("TEST FAILED");}
+#define TEST_ASSERT_EQUALS(actual, expected) if (actual != expected) { std::cerr << "TEST EQUALITY ASSERTION FAILED at " << __FILE__  << ":" <<__LINE__ << "\nActual: " << actual << "\nExpected: " << expected << "\n"; throw std::runtime_error("TEST FAILED");}
+#define TEST_ASSERT_EQUALS_NOPRINT(actual, expected) if (actual != expected) { std::cerr << "TEST EQUALITY ASSERTION FAILED at " << __FILE__  << ":" <<__LINE__ << "\n" << #actual << " != " << #expected << "\n"; throw std::runtime_error("TEST FAILED");}
+
+#endif // ULXR_TEST_ASSERTS_H
@@ -0,0 +1,243 @@
+#include <ulxmlrpcpp/ulxmlrpcpp.h>
+#include <ulxmlrpcpp/ulxr_value.h>
+#include <ulxmlrpcpp/ulxr_valueparse.h>
+#include <ulxmlrpcpp/ulxr_except.h>
+
+#include <ctime>
+#include <iostream>
+#include <string>
+
+#include "test_asserts.h"
+
+// parses a value with expat and with the native parser, returns false if it is rejected
+bool parseValue(const std::string &xml, ulxr::Value &value)
+{
+    bool accepted[2];
+    std::string parsed[2];
+    for (int native = 0; native < 2; ++native)
+    {
+        try
+        {
+            ulxr::ValueParser parser;
+            parser.useNativeParser(native != 0);
+            accepted[native] = parser.parse(xml.data(), xml.length(), true) != 0;
+            if (accepted[native])
+            {
+                value = parser.getValue();
+                parsed[native] = value.getXml(0);
+            }
+        }
+        catch (ulxr::XmlException &)
+        {
+            accepted[native] = false;
+        }
+    }
+
+    // both parsers agree
+    TEST_ASSERT_EQUALS(accepted[0], accepted[1]);
+    TEST_ASSERT_EQUALS(parsed[0], parsed[1]);
+    return accepted[0];
+}
+
+bool parseInteger(const std::string &tag, const std::string &content, int &i)
+{
+    ulxr::Value value;
+    if (!parseValue("<value><" + tag + ">" + content + "</" + tag + "></value>", value))
+        return false;
+    TEST_ASSERT(value.isInteger());
+    i = ulxr::Integer(value).getInteger();
+    return true;
+}
+
+bool parseDouble(const std::string &content, double &d)
+{
+    ulxr::Value value;
+    if (!parseValue("<value><double>" + content + "</double></value>", value))
+        return false;
+    TEST_ASSERT(value.isDouble());
+    d = ulxr::Double(value).getDouble();
+    return true;
+}
+
+void testNumbers()
+{
+    for (const char *tag : {"int", "i4"})
+    {
+        int i = 0;
+        TEST_ASSERT(parseInteger(tag, "42", i) && i == 42);
+        TEST_ASSERT(parseInteger(tag, "2147483647", i) && i == 2147483647);
+        TEST_ASSERT(parseInteger(tag, "-2147483648", i) && i == -2147483647 - 1);
+        TEST_ASSERT(parseInteger(tag, "+7", i) && i == 7);
+        TEST_ASSERT(parseInteger(tag, "007", i) && i == 7);
+
+        // surrounding white space is ignored
+        TEST_ASSERT(parseInteger(tag, "  12\t", i) && i == 12);
+        TEST_ASSERT(parseInteger(tag, "\r\n -3 \n", i) && i == -3);
+
+        // out of range
+        TEST_ASSERT(!parseInteger(tag, "2147483648", i));
+        TEST_ASSERT(!parseInteger(tag, "-2147483649", i));
+        TEST_ASSERT(!parseInteger(tag, "99999999999999999999", i));
+
+        // only decimal digits
+        TEST_ASSERT(!parseInteger(tag, "0x10", i));
+        TEST_ASSERT(!parseInteger(tag, "1.5", i));
+        TEST_ASSERT(!parseInteger(tag, "1e3", i));
+        TEST_ASSERT(!parseInteger(tag, "12abc", i));
+        TEST_ASSERT(!parseInteger(tag, "1 2", i));
+        TEST_ASSERT(!parseInteger(tag, "+-5", i));
+        TEST_ASSERT(!parseInteger(tag, "++5", i));
+        TEST_ASSERT(!parseInteger(tag, "-", i));
+
+        // empty
+        TEST_ASSERT(!parseInteger(tag, "", i));
+        TEST_ASSERT(!parseInteger(tag, "  ", i));
+        ulxr::Value value;
+        TEST_ASSERT(!parseValue(std::string("<value><") + tag + "/></value>", value));
+    }
+
+    double d = 0;
+    TEST_ASSERT(parseDouble("1.5", d) && d == 1.5);
+    TEST_ASSERT(parseDouble("-0.25", d) && d == -0.25);
+    TEST_ASSERT(parseDouble("+3", d) && d == 3);
+    TEST_ASSERT(parseDouble("1e300", d) && d == 1e300);
+    TEST_ASSERT(parseDouble("123.4567E12", d) && d == 123.4567E12);
+    TEST_ASSERT(parseDouble("2147483648", d) && d == 2147483648.0);
+    TEST_ASSERT(parseDouble(" \t1.25\r\n ", d) && d == 1.25);
+
+    TEST_ASSERT(!parseDouble("1e400", d));
+    TEST_ASSERT(!parseDouble("-1e400", d));
+    TEST_ASSERT(!parseDouble("0x10", d));
+    TEST_ASSERT(!parseDouble("1.5.1", d));
+    TEST_ASSERT(!parseDouble("1,5", d));
+    TEST_ASSERT(!parseDouble("1 5", d));
+    TEST_ASSERT(!parseDouble("", d));
+    TEST_ASSERT(!parseDouble(" ", d));
+    ulxr::Value value;
+    TEST_ASSERT(!parseValue("<value><double/></value>", value));
+}
+
+std::string dateXml(const std::string &date)
+{
+    return "<value><dateTime.iso8601>" + date + "</dateTime.iso8601></value>";
+}
+
+std::time_t localTime(int year, int month, int day, int hour, int min, int sec)
+{
+    std::tm t = std::tm();
+    t.tm_year = year - 1900;
+    t.tm_mon = month - 1;
+    t.tm_mday = day;
+    t.tm_hour = hour;
+    t.tm_min = min;
+    t.tm_sec = sec;
+    t.tm_isdst = -1;
+    return std::mktime(&t);
+}
+
+void testDateTime()
+{
+    // the four accepted forms are kept as they are
+    for (const char *date : {"19980717T14:08:55", "1998-07-17T14:08:55", "19980717T140855", "1998-07-17T140855"})
+    {
+        ulxr::DateTime dt(date);
+        TEST_ASSERT(dt.isValid());
+        TEST_ASSERT_EQUALS(dt.getDateTime(), date);
+        TEST_ASSERT_EQUALS(dt.getTimeT(), localTime(1998, 7, 17, 14, 8, 55));
+        TEST_ASSERT_EQUALS(dt.getXml(0), dateXml(date));
+
+        ulxr::Value value;
+        TEST_ASSERT(parseValue(dateXml(date), value));
+        TEST_ASSERT(value.isDateTime());
+        TEST_ASSERT_EQUALS(ulxr::DateTime(value).getDateTime(), date);
+        TEST_ASSERT_EQUALS(value.getXml(0), dateXml(date));
+    }
+
+    // the limits of the calendar
+    for (const char *date : {"20000229T00:00:00", "20240229T23:59:59", "19991231T23:59:59", "20001231T12:00:00",
+                             "00010101T00:00:00", "99991231T23:59:59", "19000301T00:00:00", "19691231T23:59:59"})
+    {
+        ulxr::DateTime dt(date);
+        TEST_ASSERT(dt.isValid());
+        TEST_ASSERT_EQUALS(dt.getDateTime(), date);
+        ulxr::Value value;
+        TEST_ASSERT(parseValue(dateXml(date), value));
+        TEST_ASSERT_EQUALS(ulxr::DateTime(value).getDateTime(), date);
+    }
+
+    // other text is stored verbatim but rejected by the parser
+    for (const char *date : {"19980230T14:08:55", "19990229T14:08:55", "19000229T14:08:55", "19981317T14:08:55",
+                             "19980017T14:08:55", "19980700T14:08:55", "19980731T24:00:00", "19980731T23:60:00",
+                             "19980731T23:59:60", "1998-0717T14:08:55", "199807-17T14:08:55", "19980717T14:0855",
+                             "19980717T1408:55", "19980717 14:08:55", "19980717T14:08:55Z", "1998-07-17T14:08:55+01:00",
+                             "19980717", "98-07-17T14:08:55", "1998O717T14:08:55", "garbage", ""})
+    {
+        ulxr::DateTime dt(date);
+        TEST_ASSERT(!dt.isValid());
+        TEST_ASSERT_EQUALS(dt.getDateTime(), date);
+        TEST_ASSERT_EQUALS(dt.getXml(0), dateXml(date));
+
+        bool thrown = false;
+        try
+        {
+            dt.getTimeT();
+        }
+        catch (ulxr::ParameterException &)
+        {
+            thrown = true;
+        }
+        TEST_ASSERT(thrown);
+
+        ulxr::Value value;
+        TEST_ASSERT(!parseValue(dateXml(date), value));
+    }
+
+    // a std::time_t is taken as local time in the form selected
+    const std::time_t t = localTime(2026, 1, 2, 3, 4, 5);
+    ulxr::DateTime dt(t);
+    TEST_ASSERT_EQUALS(dt.getDateTime(), "20260102T03:04:05");
+    TEST_ASSERT_EQUALS(dt.getTimeT(), t);
+    dt.setDateTime(t, true, false);
+    TEST_ASSERT_EQUALS(dt.getDateTime(), "2026-01-02T030405");
+    dt.setDateTime(t, true, true);
+    TEST_ASSERT_EQUALS(dt.getDateTime(), "2026-01-02T03:04:05");
+    dt.setDateTime(t, false, false);
+    TEST_ASSERT_EQUALS(dt.getDateTime(), "20260102T030405");
+    TEST_ASSERT_EQUALS(dt.getTimeT(), t);
+
+    // the round trip through a string keeps the time
+    for (std::time_t tt : {localTime(1970, 1, 1, 12, 0, 0), localTime(1998, 7, 17, 14, 8, 55),
+                           localTime(2038, 1, 19, 3, 14, 8), localTime(1960, 6, 15, 12, 30, 0)})
+    {
+        TEST_ASSERT_EQUALS(ulxr::DateTime(ulxr::DateTime(tt).getDateTime()).getTimeT(), tt);
+
+        ulxr::Value value;
+        TEST_ASSERT(parseValue(ulxr::DateTime(tt).getXml(0), value));
+        TEST_ASSERT_EQUALS(ulxr::DateTime(value).getTimeT(), tt);
+    }
+
+    // the default is no valid date
+    TEST_ASSERT(!ulxr::DateTime().isValid());
+}
+
+////////////////////////////////////////////////////////////////////////
+int main()
+{
+    try
+    {
+        testNumbers();
+        testDateTime();
+    }
+    catch(ulxr::Exception &ex)
+    {
+        std::cerr << "Error occurred: " << ex.why() << std::endl;
+        return 1;
+    }
+    catch(std::exception &ex)
+    {
+        std::cerr << "Error occurred: " << ex.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -31,8 +31,71 @@
 #include <iostream>
 #include <ctime>
 #include <cstring>
+#include <cstdlib>
+#include <cstdio>
+#include <new>
+#include <map>
 
+#include <ulxmlrpcpp/ulxr_base64.h>
 #include <ulxmlrpcpp/ulxr_value.h>
+#include <ulxmlrpcpp/ulxr_valueparse.h>
+#include <ulxmlrpcpp/ulxr_callparse.h>
+#include <ulxmlrpcpp/ulxr_call.h>
+#include <ulxmlrpcpp/ulxr_xmlsink.h>
+#include <ulxmlrpcpp/ulxr_http_protocol.h>
+
+
+namespace {
+
+    unsigned long allocations = 0;
+
+    long msecSince(std::clock_t start)
+    {
+        return (std::clock() - start) * 1000 / CLOCKS_PER_SEC;
+    }
+
+    void report(const char *what, std::clock_t start, unsigned long allocs_before)
+    {
+        std::cout << what << ": " << msecSince(start) << " ms, "
+                  << (allocations - allocs_before) << " allocations\n";
+    }
+
+}
+
+
+void *operator new(std::size_t size)
+{
+    ++allocations;
+    void *p = std::malloc(size != 0 ? size : 1);
+    if (p == 0)
+        throw std::bad_alloc();
+    return p;
+}
+
+
+void operator delete(void *p) noexcept
+{
+    std::free(p);
+}
+
+
+// std::pmr::new_delete_resource() and thus the containers of the values
+// allocate with the aligned form
+void *operator new(std::size_t size, std::align_val_t align)
+{
+    ++allocations;
+    const std::size_t alignment = static_cast<std::size_t>(align);
+    void *p = std::aligned_alloc(alignment, (size / alignment + 1) * alignment);
+    if (p == 0)
+        throw std::bad_alloc();
+    return p;
+}
+
+
+void operator delete(void *p, std::align_val_t) noexcept
+{
+    std::free(p);
+}
 
 
 int main(int argc, char ** argv)
@@ -87,6 +150,559 @@ int main(int argc, char ** argv)
                   << secs << std::endl;
 
 
+////////////////////////////////////////////////////////////////
+
+        const unsigned numInts = 1000000;
+        std::cout << "\nStarting measuring for an array of " << numInts << " integers\n";
+
+        std::clock_t start = std::clock();
+        unsigned long allocs = allocations;
+        ulxr::Array intarr;
+        for (unsigned i = 0; i < numInts; ++i)
+            intarr.addItem(ulxr::Integer(i));
+        report("Build", start, allocs);
+
+        start = std::clock();
+        allocs = allocations;
+        std::string intxml = intarr.getXml();
+        report("Serialize", start, allocs);
+
+        start = std::clock();
+        allocs = allocations;
+        if (intarr.getIntVector().size() != numInts)
+            return 1;
+        report("Bulk read", start, allocs);
+
+        start = std::clock();
+        allocs = allocations;
+        {
+            ulxr::ValueParser parser;
+            if (!parser.parse(intxml.data(), intxml.length(), true))
+            {
+                std::cout << "Parse error: " << parser.getErrorString(parser.getErrorCode()) << std::endl;
+                return 1;
+            }
+            ulxr::Value val = parser.getValue();
+            const ulxr::Array &parsed = val;
+            if (parsed.size() != numInts)
+                return 1;
+        }
+        report("Parse", start, allocs);
+
+        start = std::clock();
+        allocs = allocations;
+        {
+            ulxr::ValueParser parser;
+            parser.useNativeParser(true);
+            if (!parser.parse(intxml.data(), intxml.length(), true))
+            {
+                std::cout << "Parse error: " << parser.getErrorString(parser.getErrorCode()) << std::endl;
+                return 1;
+            }
+            ulxr::Value val = parser.getValue();
+            const ulxr::Array &parsed = val;
+            if (parsed.size() != numInts)
+                return 1;
+        }
+        report("Parse with native parser", start, allocs);
+
+////////////////////////////////////////////////////////////////
+
+        const unsigned numDoubles = 1000000;
+        std::cout << "\nStarting measuring for an array of " << numDoubles << " doubles\n";
+
+        std::vector<double> doublevec(numDoubles);
+        for (unsigned i = 0; i < numDoubles; ++i)
+            doublevec[i] = (i * 7919.0 - 3e6) / 1024.0 + i / 3.0;
+        const ulxr::Array doublearr(doublevec);
+
+        const ulxr::Double::Format prevFormat = ulxr::Double::getFormat();
+        const char *formatNames[] = { "fixed", "scientific", "shortest" };
+        for (unsigned f = ulxr::Double::FixedFormat; f <= ulxr::Double::ShortestFormat; ++f)
+        {
+            ulxr::Double::setFormat(ulxr::Double::Format(f));
+            std::string doublexml;
+            start = std::clock();
+            allocs = allocations;
+            ulxr::XmlSink sink(doublexml);
+            doublearr.serialize(sink);
+            std::cout << "Serialize " << formatNames[f] << ": " << msecSince(start) << " ms, "
+                      << (allocations - allocs) << " allocations, " << doublexml.length() << " bytes\n";
+
+            if (f == ulxr::Double::ShortestFormat)
+            {
+                ulxr::ValueParser parser;
+                if (!parser.parse(doublexml.data(), doublexml.length(), true))
+                    return 1;
+                ulxr::Value val = parser.getValue();
+                const ulxr::Array &parsed = val;
+                if (parsed.getDoubleVector() != doublevec)
+                    return 1;
+            }
+        }
+        ulxr::Double::setFormat(prevFormat);
+
+        start = std::clock();
+        for (unsigned i = 0; i < numInts; ++i)
+            us = ulxr::toString(i);
+        report("toString for integers", start, allocs = allocations);
+
+////////////////////////////////////////////////////////////////
+
+        const char *names[] = { "id", "name", "description", "created", "modified",
+                                "owner", "group", "permissions", "size", "checksum",
+                                "mimeType", "encoding", "version", "status", "priority",
+                                "tags", "parent", "children", "url", "comment" };
+        const unsigned numNames = sizeof(names) / sizeof(names[0]);
+        const unsigned numLookups = 10000000;
+        const unsigned numRecords = 100000;
+
+        std::cout << "\nStarting measuring for structs with " << numNames << " members\n";
+
+        ulxr::Struct record;
+        std::map<std::string, ulxr::Value> maprecord;
+        for (unsigned i = 0; i < numNames; ++i)
+        {
+            if (i % 2)
+            {
+                record.addMember(names[i], ulxr::Integer(i));
+                maprecord.insert(std::make_pair(names[i], ulxr::Value(ulxr::Integer(i))));
+            }
+            else
+            {
+                record.addMember(names[i], ulxr::RpcString(names[i]));
+                maprecord.insert(std::make_pair(names[i], ulxr::Value(ulxr::RpcString(names[i]))));
+            }
+        }
+
+        std::vector<std::string> keys(names, names + numNames);
+        unsigned found = 0;
+        start = std::clock();
+        for (unsigned i = 0; i < numLookups; ++i)
+            found += maprecord.find(keys[i % numNames]) != maprecord.end();
+        report("Lookup std::map (reference)", start, allocs = allocations);
+
+        start = std::clock();
+        for (unsigned i = 0; i < numLookups; ++i)
+            found += record.hasMember(keys[i % numNames]);
+        report("Lookup Struct", start, allocs = allocations);
+
+        std::vector<ulxr::MemberName> internedkeys(keys.begin(), keys.end());
+        start = std::clock();
+        for (unsigned i = 0; i < numLookups; ++i)
+            found += record.hasMember(internedkeys[i % numNames]);
+        report("Lookup Struct with MemberName", start, allocs = allocations);
+
+        if (found != 3 * numLookups)
+            return 1;
+
+        start = std::clock();
+        allocs = allocations;
+        ulxr::Array records;
+        for (unsigned i = 0; i < numRecords; ++i)
+            records.addItem(record);
+        report("Build records", start, allocs);
+
+        start = std::clock();
+        allocs = allocations;
+        std::string recxml = records.getXml();
+        report("Serialize records", start, allocs);
+
+        std::string recbuffer;
+        for (unsigned i = 0; i < 2; ++i)
+        {
+            start = std::clock();
+            allocs = allocations;
+            recbuffer.clear();
+            ulxr::XmlSink sink(recbuffer);
+            records.serialize(sink);
+            report(i == 0 ? "Serialize records into buffer"
+                          : "Serialize records into reused buffer", start, allocs);
+        }
+        if (recbuffer != recxml)
+            return 1;
+
+        start = std::clock();
+        allocs = allocations;
+        if (records.getXmlSize(ulxr::XmlWriterOptions()) != recxml.length())
+            return 1;
+        report("Size records", start, allocs);
+
+        ulxr::Array catalog;
+        for (unsigned i = 0; i < 1000; ++i)
+            catalog.addItem(record);
+        const unsigned numResponses = 1000;
+        for (unsigned cached = 0; cached < 2; ++cached)
+        {
+            start = std::clock();
+            allocs = allocations;
+            const ulxr::Value content = cached ? ulxr::Value(ulxr::RawXml(catalog)) : ulxr::Value(catalog);
+            std::size_t written = 0;
+            for (unsigned i = 0; i < numResponses; ++i)
+            {
+                ulxr::Struct response;
+                response.addMember("request", ulxr::Integer(i));
+                response.addMember("catalog", content);
+                recbuffer.clear();
+                ulxr::XmlSink sink(recbuffer);
+                response.serialize(sink);
+                written += recbuffer.length();
+            }
+            report(cached ? "Responses with cached catalog"
+                          : "Responses with catalog", start, allocs);
+            if (written < numResponses * catalog.size())
+                return 1;
+        }
+
+        start = std::clock();
+        allocs = allocations;
+        {
+            ulxr::ValueParser parser;
+            if (!parser.parse(recxml.data(), recxml.length(), true))
+            {
+                std::cout << "Parse error: " << parser.getErrorString(parser.getErrorCode()) << std::endl;
+                return 1;
+            }
+            ulxr::Value val = parser.getValue();
+            const ulxr::Array &parsed = val;
+            if (parsed.size() != numRecords)
+                return 1;
+        }
+        report("Parse records", start, allocs);
+
+        start = std::clock();
+        allocs = allocations;
+        {
+            ulxr::ValueParser parser;
+            parser.useNativeParser(true);
+            if (!parser.parse(recxml.data(), recxml.length(), true))
+            {
+                std::cout << "Parse error: " << parser.getErrorString(parser.getErrorCode()) << std::endl;
+                return 1;
+            }
+            ulxr::Value val = parser.getValue();
+            const ulxr::Array &parsed = val;
+            if (parsed.size() != numRecords)
+                return 1;
+        }
+        report("Parse records with native parser", start, allocs);
+
+        start = std::clock();
+        allocs = allocations;
+        {
+            ulxr::ValueParser parser;
+            parser.useArena(true);
+            if (!parser.parse(recxml.data(), recxml.length(), true))
+            {
+                std::cout << "Parse error: " << parser.getErrorString(parser.getErrorCode()) << std::endl;
+                return 1;
+            }
+            ulxr::Value val = parser.getValue();
+            const ulxr::Array &parsed = val;
+            if (parsed.size() != numRecords)
+                return 1;
+        }
+        report("Parse records into arena", start, allocs);
+
+////////////////////////////////////////////////////////////////
+
+        const unsigned numWide = 100000;
+        std::cout << "\nStarting measuring for a struct with " << numWide << " members in reverse order\n";
+
+        std::vector<std::string> widenames;
+        for (unsigned i = 0; i < numWide; ++i)
+        {
+            char name[16];
+            std::snprintf(name, sizeof(name), "m%06u", numWide - 1 - i);
+            widenames.push_back(name);
+        }
+
+        start = std::clock();
+        allocs = allocations;
+        ulxr::Struct wide;
+        for (unsigned i = 0; i < numWide; ++i)
+            wide.addMember(widenames[i], ulxr::Integer(i));
+        if (wide.getMemberNames().front() != widenames.back())
+            return 1;
+        report("Build reversed struct", start, allocs);
+
+        std::string widexml = "<value><struct>";
+        for (unsigned i = 0; i < numWide; ++i)
+            widexml += "<member><name>" + widenames[i] + "</name><value><i4>1</i4></value></member>";
+        widexml += "</struct></value>";
+
+        start = std::clock();
+        allocs = allocations;
+        {
+            ulxr::ValueParser parser;
+            if (!parser.parse(widexml.data(), widexml.length(), true))
+            {
+                std::cout << "Parse error: " << parser.getErrorString(parser.getErrorCode()) << std::endl;
+                return 1;
+            }
+            ulxr::Value val = parser.getValue();
+            const ulxr::Struct &parsed = val;
+            if (parsed.size() != numWide || !parsed.hasMember(widenames[0]))
+                return 1;
+        }
+        report("Parse reversed struct", start, allocs);
+
+////////////////////////////////////////////////////////////////
+
+        const unsigned blobSize = 4 * 1024 * 1024;
+
+        std::cout << "\nStarting measuring for a base64 blob of " << blobSize << " bytes\n";
+
+        std::string blob(blobSize, '\0');
+        for (unsigned i = 0; i < blobSize; ++i)
+            blob[i] = char(i * 7 + i / 251);
+
+        start = std::clock();
+        allocs = allocations;
+        std::string blobxml = ulxr::Value(ulxr::Base64(blob)).getXml();
+        report("Serialize blob", start, allocs);
+
+        start = std::clock();
+        allocs = allocations;
+        {
+            ulxr::ValueParser parser;
+            if (!parser.parse(blobxml.data(), blobxml.length(), true))
+            {
+                std::cout << "Parse error: " << parser.getErrorString(parser.getErrorCode()) << std::endl;
+                return 1;
+            }
+            if (parser.getValue().getXml() != blobxml)
+                return 1;
+        }
+        report("Relay blob", start, allocs);
+
+        start = std::clock();
+        allocs = allocations;
+        {
+            ulxr::ValueParser parser;
+            if (!parser.parse(blobxml.data(), blobxml.length(), true))
+            {
+                std::cout << "Parse error: " << parser.getErrorString(parser.getErrorCode()) << std::endl;
+                return 1;
+            }
+            ulxr::Value val = parser.getValue();
+            const ulxr::Base64 &parsed = val;
+            for (unsigned i = 0; i < 3; ++i)
+                if (parsed.getString() != blob)
+                    return 1;
+        }
+        report("Decode blob 3 times", start, allocs);
+
+        const char *kernelNames[] = { "scalar", "ssse3", "avx2" };
+        const ulxr::Base64Kernel defaultKernel = ulxr::getBase64Kernel();
+        const std::vector<unsigned char> rawblob(blob.begin(), blob.end());
+        const unsigned rounds = 20;
+        for (unsigned k = ulxr::Base64Scalar; k <= ulxr::Base64Avx2; ++k)
+        {
+            if (!ulxr::setBase64Kernel(ulxr::Base64Kernel(k)))
+                continue;
+
+            std::string encoded;
+            start = std::clock();
+            for (unsigned i = 0; i < rounds; ++i)
+                encoded = ulxr::toBase64(rawblob);
+            long ms = msecSince(start);
+            std::cout << "Encode with " << kernelNames[k] << ": "
+                      << (ms ? rounds * (blobSize / 1024) / ms : 0) << " MB/s\n";
+
+            std::vector<unsigned char> decoded;
+            start = std::clock();
+            for (unsigned i = 0; i < rounds; ++i)
+                decoded = ulxr::fromBase64(encoded);
+            ms = msecSince(start);
+            std::cout << "Decode with " << kernelNames[k] << ": "
+                      << (ms ? rounds * (blobSize / 1024) / ms : 0) << " MB/s\n";
+
+            if (decoded != rawblob)
+                return 1;
+        }
+        ulxr::setBase64Kernel(defaultKernel);
+
+////////////////////////////////////////////////////////////////
+
+        std::cout << "\nStarting measuring for escaping strings\n";
+
+        const std::string prose = "The quick brown fox jumps over the lazy dog, "
+                                  "then it runs back into the forest. ";
+        const std::string markup = "<p class=\"note\">Tom & Jerry's</p>\n";
+        std::vector<std::string> payloads[3];
+        const char *payloadNames[] = { "names", "prose", "markup" };
+        for (unsigned i = 0; i < 100000; ++i)
+            payloads[0].push_back("member_name_" + ulxr::toString(i));
+        for (unsigned i = 0; i < 1000; ++i)
+        {
+            std::string text;
+            while (text.length() < 1000)
+                text += i % 10 == 0 ? markup : prose;
+            payloads[1].push_back(text);
+        }
+        for (unsigned i = 0; i < 1000; ++i)
+        {
+            std::string text;
+            while (text.length() < 1000)
+                text += markup;
+            payloads[2].push_back(text);
+        }
+
+        for (unsigned p = 0; p < 3; ++p)
+        {
+            std::size_t bytes = 0;
+            for (unsigned i = 0; i < payloads[p].size(); ++i)
+                bytes += payloads[p][i].length();
+
+            std::size_t escaped = 0;
+            start = std::clock();
+            allocs = allocations;
+            for (unsigned r = 0; r < rounds; ++r)
+                for (unsigned i = 0; i < payloads[p].size(); ++i)
+                    escaped += ulxr::xmlEscape(payloads[p][i]).length();
+            long ms = msecSince(start);
+            std::cout << "Escape " << payloadNames[p] << " into strings: "
+                      << (ms ? rounds * (bytes / 1024) / ms : 0) << " MB/s, "
+                      << (allocations - allocs) << " allocations\n";
+
+            std::string buffer;
+            std::size_t appended = 0;
+            start = std::clock();
+            allocs = allocations;
+            for (unsigned r = 0; r < rounds; ++r)
+            {
+                buffer.clear();
+                ulxr::XmlSink sink(buffer);
+                for (unsigned i = 0; i < payloads[p].size(); ++i)
+                    sink.appendEscaped(payloads[p][i]);
+                appended += buffer.length();
+            }
+            ms = msecSince(start);
+            std::cout << "Escape " << payloadNames[p] << " into a sink: "
+                      << (ms ? rounds * (bytes / 1024) / ms : 0) << " MB/s, "
+                      << (allocations - allocs) << " allocations\n";
+
+            if (escaped != appended)
+                return 1;
+        }
+
+////////////////////////////////////////////////////////////////
+
+        std::cout << "\nStarting measuring for parsing calls\n";
+
+        ulxr::MethodCall pcall("catalog.update");
+        ulxr::Array pitems;
+        for (unsigned i = 0; i < 50; ++i)
+        {
+            ulxr::Struct item;
+            item.addMember("id", ulxr::Integer(i));
+            item.addMember("name", ulxr::RpcString("item"));
+            item.addMember("price", ulxr::Double(9.95));
+            item.addMember("available", ulxr::Boolean(true));
+            pitems.addItem(item);
+        }
+        pcall.addParam(ulxr::RpcString("update")).addParam(pitems);
+        const std::string callxml = pcall.getXml(1);
+        unsigned parsed_params = 0;
+        start = std::clock();
+        allocs = allocations;
+        for (unsigned i = 0; i < 2000; ++i)
+        {
+            ulxr::MethodCallParser parser;
+            if (!parser.parse(callxml.data(), callxml.length(), true))
+            {
+                std::cout << "Parse error: " << parser.getErrorString(parser.getErrorCode()) << std::endl;
+                return 1;
+            }
+            parsed_params += parser.numParams();
+        }
+        report("Parse calls", start, allocs);
+        if (parsed_params != 2000 * 2)
+            return 1;
+
+        parsed_params = 0;
+        start = std::clock();
+        allocs = allocations;
+        for (unsigned i = 0; i < 2000; ++i)
+        {
+            ulxr::MethodCallParser parser;
+            parser.useNativeParser(true);
+            if (!parser.parse(callxml.data(), callxml.length(), true))
+            {
+                std::cout << "Parse error: " << parser.getErrorString(parser.getErrorCode()) << std::endl;
+                return 1;
+            }
+            parsed_params += parser.numParams();
+        }
+        report("Parse calls with native parser", start, allocs);
+        if (parsed_params != 2000 * 2)
+            return 1;
+
+        // as in a server the names of the parsed calls are not used elsewhere
+        std::string freshxml;
+        {
+            ulxr::MethodCall fcall("stock.update");
+            ulxr::Array fitems;
+            for (unsigned i = 0; i < 50; ++i)
+            {
+                ulxr::Struct item;
+                item.addMember("sku", ulxr::Integer(i));
+                item.addMember("label", ulxr::RpcString("item"));
+                item.addMember("cost", ulxr::Double(9.95));
+                item.addMember("inStock", ulxr::Boolean(true));
+                fitems.addItem(item);
+            }
+            fcall.addParam(ulxr::RpcString("update")).addParam(fitems);
+            freshxml = fcall.getXml(1);
+        }
+        parsed_params = 0;
+        start = std::clock();
+        allocs = allocations;
+        for (unsigned i = 0; i < 2000; ++i)
+        {
+            ulxr::MethodCallParser parser;
+            if (!parser.parse(freshxml.data(), freshxml.length(), true))
+            {
+                std::cout << "Parse error: " << parser.getErrorString(parser.getErrorCode()) << std::endl;
+                return 1;
+            }
+            parsed_params += parser.numParams();
+        }
+        report("Parse calls with names not in use", start, allocs);
+        if (parsed_params != 2000 * 2)
+            return 1;
+
+////////////////////////////////////////////////////////////////
+
+        std::cout << "\nStarting measuring for http headers\n";
+
+        const std::string header = "HTTP/1.1 200 OK\r\n"
+                                   "Connection: Keep-Alive\r\n"
+                                   "Keep-Alive: timeout=15, max=99\r\n"
+                                   "Content-Type: text/xml\r\n"
+                                   "Content-Length: 140\r\n"
+                                   "X-Powered-By: ulxmlrpcpp/1.7.5\r\n"
+                                   "Server: localhost\r\n"
+                                   "Date: Sat Oct 17 12:00:00 2026\r\n"
+                                   "\r\n";
+        ulxr::HttpProtocol http(0, "localhost", 80);
+        long lengths = 0;
+        start = std::clock();
+        allocs = allocations;
+        for (unsigned i = 0; i < 200000; ++i)
+        {
+            http.resetConnection();
+            std::string block = header;
+            char *data = &block[0];
+            long len = block.length();
+            http.connectionMachine(data, len);
+            lengths += atoi(http.getHttpProperty("content-length").c_str());
+        }
+        report("Parse http headers", start, allocs);
+        if (lengths != 200000L * 140)
+            return 1;
+
 ////////////////////////////////////////////////////////////////
 
         /* Ratio val1_server/client:
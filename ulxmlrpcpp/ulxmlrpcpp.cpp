@@ -27,6 +27,7 @@
  *
  ***************************************************************************/
 
+#include <atomic>
 #include <cctype>
 #include <cerrno>
 #include <sstream>
@@ -40,10 +41,16 @@
 
 #include <ulxmlrpcpp/ulxmlrpcpp.h>
 #include <ulxmlrpcpp/ulxr_except.h>
+#include <ulxmlrpcpp/ulxr_base64.h>
 #include <ulxmlrpcpp/ulxr_tcpip_connection.h>
 #include <openssl/bn.h>
 #include <openssl/x509.h>
 
+#if defined(__GNUC__) && (defined(__x86_64__) || (defined(__i386__) && defined(__SSE2__)))
+#define ULXR_ESCAPE_X86
+#include <immintrin.h>
+#endif
+
 
 /** @brief Various general helper classes
   * @defgroup grp_ulxr_utilit General helper classes
@@ -154,133 +161,248 @@ namespace ulxr {
 
     std::string toBase64(const std::vector<unsigned char>& anSrc, bool aSingleLine)
     {
-        if (anSrc.empty())
-            return "";
-        BIO* myMemBio	  = BIO_new(BIO_s_mem());
-        BIO* myBase64Bio  = BIO_new(BIO_f_base64());
-        if (aSingleLine)
-            BIO_set_flags(myBase64Bio, BIO_FLAGS_BASE64_NO_NL);
-        BIO* myBio        = BIO_push(myBase64Bio, myMemBio);
-        int myWritten = BIO_write(myBio, &anSrc[0], (int)anSrc.size());
-        if (myWritten < 0 || static_cast<size_t>(myWritten) < anSrc.size())
-        {
-            BIO_free_all(myBio);
-            throw ParameterException(ApplicationError, "toBase64(): BIO_write failed.");
-        }
-        BIO_flush(myBio);
-        BUF_MEM* myEncBuf;
-        if (BIO_get_mem_ptr(myBio, &myEncBuf) < 0 || myEncBuf->length <= 0)
-        {
-            BIO_free_all(myBio);
-            throw ParameterException(ApplicationError, "toBase64(): BIO_get_mem_ptr failed.");
-        }
-        size_t myLen = (myEncBuf->data[myEncBuf->length-1] == '\n') ?
-                       static_cast<size_t>(myEncBuf->length-1) :
-                       static_cast<size_t>(myEncBuf->length);
-        std::string myRetVal(myEncBuf->data, myLen);
-        BIO_free_all(myBio);
+        std::string myRetVal(base64EncodedSize(anSrc.size(), aSingleLine), '\0');
+        base64Encode(anSrc.data(), anSrc.size(), aSingleLine, &myRetVal[0]);
         return myRetVal;
     }
 
     std::vector<unsigned char> fromBase64(const std::string& anSrc, bool aSingleLine)
     {
-        std::vector<char> mySrcVec(anSrc.begin(), anSrc.end());
-        if (mySrcVec.empty() || mySrcVec.back() != '\n')
-            mySrcVec.push_back('\n');
-        BIO* myBase64Bio  = BIO_new(BIO_f_base64());
-        if (aSingleLine)
-            BIO_set_flags(myBase64Bio, BIO_FLAGS_BASE64_NO_NL);
-        BIO* myMemBio = BIO_new_mem_buf(&mySrcVec[0], (int)mySrcVec.size());
-        myMemBio = BIO_push(myBase64Bio, myMemBio);
-        std::vector<unsigned char> myRetVal;
-        while (true)
-        {
-            unsigned char myBuf[128] = {};
-            int myRead = BIO_read(myMemBio, myBuf, sizeof(myBuf));
-            if (myRead < 0)
-            {
-                BIO_free_all(myMemBio);
-                throw ParameterException(ApplicationError, "fromBase64(): BIO_read failed.");
-            }
-            myRetVal.insert(myRetVal.end(), myBuf, myBuf + myRead);
-            if (static_cast<unsigned int>(myRead) < sizeof(myBuf))
-                break;
-        }
-        BIO_free_all(myMemBio);
+        std::vector<unsigned char> myRetVal(base64DecodedMaxSize(anSrc.size()));
+        std::size_t myLen = 0;
+        if (!base64Decode(anSrc.data(), anSrc.size(), aSingleLine, myRetVal.data(), myLen))
+            myLen = 0;
+        myRetVal.resize(myLen);
         return myRetVal;
     }
 
 
 
-    std::string xmlEscape(const std::string &str)
+    namespace
     {
-        std::string ret;
-        unsigned prev = 0;
-        unsigned len = str.length();
-        unsigned curs = 0;
-        const char *pc = str.data();
 
-        while (curs != len)
+        // what xmlEscape() writes for each character
+        struct EscapeTable
         {
-            char c = *pc++;
+            const char    *entity[256];
+            unsigned char  extra[256];    // number of characters added
+            unsigned char  escaped[256];  // bit (1 << XmlEscaping) is set if replaced
 
-            if (c == '&')
-            {
-                ret += str.substr(prev, curs-prev);
-                ret += "&amp;";
-                prev = curs+1;
-            }
-            else if (c == '<')
+            EscapeTable()
             {
-                ret += str.substr(prev, curs-prev);
-                ret += "&lt;";
-                prev = curs+1;
+                std::memset(entity, 0, sizeof(entity));
+                std::memset(extra, 0, sizeof(extra));
+                std::memset(escaped, 0, sizeof(escaped));
+                add('&', "&amp;", true);
+                add('<', "&lt;", true);
+                add('>', "&gt;", true);
+                add('\r', "&#xD;", true);
+                add('\'', "&apos;", false);
+                add('"', "&quot;", false);
+                add('\n', "&#xA;", false);
+                add('\t', "&#x9;", false);
             }
-            else if (c == '>')
+
+            void add(char c, const char *s, bool markup)
             {
-                ret += str.substr(prev, curs-prev);
-                ret += "&gt;";
-                prev = curs+1;
+                entity[static_cast<unsigned char>(c)] = s;
+                extra[static_cast<unsigned char>(c)] = std::strlen(s) - 1;
+                escaped[static_cast<unsigned char>(c)] = (1 << EscapeAll) | (markup ? 1 << EscapeMarkup : 0);
             }
-            else if (c == '\'')
+
+            bool isEscaped(char c, XmlEscaping escaping) const
             {
-                ret += str.substr(prev, curs-prev);
-                ret += "&apos;";
-                prev = curs+1;
+                return escaped[static_cast<unsigned char>(c)] & (1 << escaping);
             }
-            else if (c == '"')
+        };
+
+        const EscapeTable escapeTable;
+
+
+        /* The scanners return the position of the first character which
+           must be escaped, starting at "pos", or "len" if there is none. */
+
+        template <XmlEscaping escaping>
+        std::size_t findEscapeScalar(const char *str, std::size_t pos, std::size_t len)
+        {
+            while (pos != len && !escapeTable.isEscaped(str[pos], escaping))
+                ++pos;
+            return pos;
+        }
+
+
+#ifdef ULXR_ESCAPE_X86
+
+        template <XmlEscaping escaping>
+        std::size_t findEscapeSse2(const char *str, std::size_t pos, std::size_t len)
+        {
+            const __m128i amp = _mm_set1_epi8('&');
+            const __m128i lt = _mm_set1_epi8('<');
+            const __m128i gt = _mm_set1_epi8('>');
+            const __m128i cr = _mm_set1_epi8('\r');
+            const __m128i apos = _mm_set1_epi8('\'');
+            const __m128i quot = _mm_set1_epi8('"');
+            const __m128i lf = _mm_set1_epi8('\n');
+            const __m128i tab = _mm_set1_epi8('\t');
+
+            for (; len - pos >= 16; pos += 16)
             {
-                ret += str.substr(prev, curs-prev);
-                ret += "&quot;";
-                prev = curs+1;
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str + pos));
+                __m128i hit = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, amp),
+                                                        _mm_cmpeq_epi8(v, lt)),
+                                           _mm_or_si128(_mm_cmpeq_epi8(v, gt),
+                                                        _mm_cmpeq_epi8(v, cr)));
+                if (escaping == EscapeAll)
+                    hit = _mm_or_si128(hit, _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, apos),
+                                                                      _mm_cmpeq_epi8(v, quot)),
+                                                         _mm_or_si128(_mm_cmpeq_epi8(v, lf),
+                                                                      _mm_cmpeq_epi8(v, tab))));
+                const unsigned mask = _mm_movemask_epi8(hit);
+                if (mask != 0)
+                    return pos + __builtin_ctz(mask);
             }
-            else if (c == '\n')
+            return findEscapeScalar<escaping>(str, pos, len);
+        }
+
+
+        template <XmlEscaping escaping>
+        __attribute__((target("avx2")))
+        std::size_t findEscapeAvx2(const char *str, std::size_t pos, std::size_t len)
+        {
+            const __m256i amp = _mm256_set1_epi8('&');
+            const __m256i lt = _mm256_set1_epi8('<');
+            const __m256i gt = _mm256_set1_epi8('>');
+            const __m256i cr = _mm256_set1_epi8('\r');
+            const __m256i apos = _mm256_set1_epi8('\'');
+            const __m256i quot = _mm256_set1_epi8('"');
+            const __m256i lf = _mm256_set1_epi8('\n');
+            const __m256i tab = _mm256_set1_epi8('\t');
+
+            for (; len - pos >= 32; pos += 32)
             {
-                ret += str.substr(prev, curs-prev);
-                ret += "&#xA;";
-                prev = curs+1;
+                const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(str + pos));
+                __m256i hit = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, amp),
+                                                              _mm256_cmpeq_epi8(v, lt)),
+                                              _mm256_or_si256(_mm256_cmpeq_epi8(v, gt),
+                                                              _mm256_cmpeq_epi8(v, cr)));
+                if (escaping == EscapeAll)
+                    hit = _mm256_or_si256(hit, _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, apos),
+                                                                               _mm256_cmpeq_epi8(v, quot)),
+                                                               _mm256_or_si256(_mm256_cmpeq_epi8(v, lf),
+                                                                               _mm256_cmpeq_epi8(v, tab))));
+                const unsigned mask = _mm256_movemask_epi8(hit);
+                if (mask != 0)
+                    return pos + __builtin_ctz(mask);
             }
-            else if (c == '\r')
+            return findEscapeSse2<escaping>(str, pos, len);
+        }
+
+#endif // ULXR_ESCAPE_X86
+
+
+        typedef std::size_t (*FindEscape)(const char *, std::size_t, std::size_t);
+
+        struct FindEscapeKernels
+        {
+            FindEscape kernel[2];  // indexed by XmlEscaping
+
+            FindEscapeKernels()
             {
-                ret += str.substr(prev, curs-prev);
-                ret += "&#xD;";
-                prev = curs+1;
+#ifdef ULXR_ESCAPE_X86
+                if (__builtin_cpu_supports("avx2"))
+                {
+                    kernel[EscapeAll] = findEscapeAvx2<EscapeAll>;
+                    kernel[EscapeMarkup] = findEscapeAvx2<EscapeMarkup>;
+                }
+                else
+                {
+                    kernel[EscapeAll] = findEscapeSse2<EscapeAll>;
+                    kernel[EscapeMarkup] = findEscapeSse2<EscapeMarkup>;
+                }
+#else
+                kernel[EscapeAll] = findEscapeScalar<EscapeAll>;
+                kernel[EscapeMarkup] = findEscapeScalar<EscapeMarkup>;
+#endif
             }
-            else if (c == '\t')
+        };
+
+
+        std::size_t findEscape(const char *str, std::size_t pos, std::size_t len, XmlEscaping escaping)
+        {
+            // entities in markup are often close together, look at the
+            // next few characters before starting the vector kernel
+            const std::size_t near = len - pos < 8 ? len : pos + 8;
+            for (; pos != near; ++pos)
+                if (escapeTable.isEscaped(str[pos], escaping))
+                    return pos;
+
+            static const FindEscapeKernels kernels;
+            return pos == len ? len : kernels.kernel[escaping](str, pos, len);
+        }
+
+
+        // writes the escaped form of str into dst beginning at the first
+        // character to escape, dst must be large enough
+        void writeEscaped(std::string_view str, std::size_t first, XmlEscaping escaping, char *dst)
+        {
+            const char *src = str.data();
+            const std::size_t len = str.length();
+            std::memcpy(dst, src, first);
+            dst += first;
+
+            std::size_t pos = first;
+            while (pos != len)
             {
-                ret += str.substr(prev, curs-prev);
-                ret += "&#x9;";
-                prev = curs+1;
+                const char *entity = escapeTable.entity[static_cast<unsigned char>(src[pos])];
+                const std::size_t elen = escapeTable.extra[static_cast<unsigned char>(src[pos])] + 1;
+                std::memcpy(dst, entity, elen);
+                dst += elen;
+
+                const std::size_t next = findEscape(src, ++pos, len, escaping);
+                std::memcpy(dst, src + pos, next - pos);
+                dst += next - pos;
+                pos = next;
             }
+        }
+
+    }
 
 
-            ++curs;
-        }
-        ret += str.substr(prev, curs-prev);
+    std::string xmlEscape(std::string_view str, XmlEscaping escaping)
+    {
+        std::string ret;
+        xmlEscape(str, ret, escaping);
         return ret;
     }
 
 
+    void xmlEscape(std::string_view str, std::string &out, XmlEscaping escaping)
+    {
+        const std::size_t first = findEscape(str.data(), 0, str.length(), escaping);
+        if (first == str.length())
+        {
+            out.append(str.data(), str.length());
+            return;
+        }
+
+        const std::size_t old = out.size();
+        out.resize(old + first + xmlEscapedSize(str.substr(first), escaping));
+        writeEscaped(str, first, escaping, &out[old]);
+    }
+
+
+    std::size_t xmlEscapedSize(std::string_view str, XmlEscaping escaping)
+    {
+        std::size_t size = str.length();
+        const std::size_t len = str.length();
+        for (std::size_t pos = findEscape(str.data(), 0, len, escaping);
+             pos != len;
+             pos = findEscape(str.data(), pos + 1, len, escaping))
+            size += escapeTable.extra[static_cast<unsigned char>(str[pos])];
+        return size;
+    }
+
+
     namespace
     {
 
@@ -312,13 +434,18 @@ namespace ulxr {
 
     namespace
     {
-        bool pretty_xml  = false;
+        std::atomic<bool> pretty_xml(false);
     }
 
 
     void enableXmlPrettyPrint(bool pretty)
     {
-        pretty_xml = pretty;
+        pretty_xml.store(pretty, std::memory_order_relaxed);
+    }
+
+    bool isXmlPrettyPrint()
+    {
+        return pretty_xml.load(std::memory_order_relaxed);
     }
 
     namespace
@@ -330,7 +457,7 @@ namespace ulxr {
 
     std::string getXmlLinefeed()
     {
-        if (pretty_xml)
+        if (isXmlPrettyPrint())
             return normal_LF;
 
         else
@@ -340,7 +467,7 @@ namespace ulxr {
 
     std::string getXmlIndent(unsigned indent)
     {
-        if (pretty_xml)
+        if (isXmlPrettyPrint())
             return std::string(indent, ' ');
 
         else
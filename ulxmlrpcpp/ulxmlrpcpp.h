@@ -57,7 +57,10 @@
 // #define ULXR_SHOW_XML
 
 
+#include <charconv>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <vector>
 #include <sstream>
 #include <iostream>
@@ -126,9 +129,11 @@
 /////////////////////////////////////////////////////////////
 //
 
-#define ULXR_RECV_BUFFER_SIZE  50    // keep rather small, otherwise two messages
-// might be read as a single block
+#define ULXR_RECV_BUFFER_SIZE  16384 // the Protocol keeps bytes beyond the
+// current message for the next one
 #define ULXR_SEND_BUFFER_SIZE  2000
+#define ULXR_MAX_HEADER_SIZE   65536 // longer http headers are rejected
+#define ULXR_MAX_XML_DEPTH     1024  // deeper nested elements are rejected by the PullParser
 
 namespace ulxr
 {
@@ -172,7 +177,6 @@ namespace ulxr
       @param[in] anSrc String which needs to be encoded
       @param[in] aSingleLine If true, mimics the behavior of 'openssl base64 -e -A' otherwise 'openssl base64 -e'
       @return Encoded string
-      @throw std::exception
      */
     std::string toBase64(const std::vector<unsigned char>& anSrc, bool aSingleLine = false);
 
@@ -181,18 +185,42 @@ namespace ulxr
 
       @param[in] anSrc String which needs to be decoded
       @param[in] aSingleLine If true, mimics the behavior of 'openssl base64 -d -A' otherwise 'openssl base64 -d'
-      @return Decoded string
-      @throw std::exception
+      @return Decoded string, empty if anSrc is not valid Base64
      */
     std::vector<unsigned char> fromBase64(const std::string& anSrc, bool aSingleLine = false);
 
+    /** Selects the characters \c xmlEscape() replaces.
+    */
+    enum XmlEscaping
+    {
+        EscapeAll,     //!< markup, quotes, tabs and line breaks
+        EscapeMarkup   //!< only what element content needs: & < > and carriage return
+    };
+
     /** Replaces dangerous sequences in xml strings.
     * Several characters have a special meaning in xml and must be
     * converted to not disturb parsing.
-    * @param  str   the string to escape
+    * @param  str        the string to escape
+    * @param  escaping   the characters to replace
     * @return the converted string
     */
-    std::string xmlEscape(const std::string &str);
+    std::string xmlEscape(std::string_view str, XmlEscaping escaping = EscapeAll);
+
+    /** Appends a string to another after replacing dangerous sequences.
+    * Strings without such sequences are appended unchanged, otherwise
+    * the escaped form is written directly into \c out.
+    * @param  str        the string to escape
+    * @param  out        receives the converted string, existing content is kept
+    * @param  escaping   the characters to replace
+    */
+    void xmlEscape(std::string_view str, std::string &out, XmlEscaping escaping = EscapeAll);
+
+    /** Returns the size of a string after \c xmlEscape().
+    * @param  str        the string to escape
+    * @param  escaping   the characters to replace
+    * @return number of characters of the converted string
+    */
+    std::size_t xmlEscapedSize(std::string_view str, XmlEscaping escaping = EscapeAll);
 
     /** Converts string into lowercase.
     * Since the C-library is used this is only valid for ascii characters
@@ -209,9 +237,22 @@ namespace ulxr
     template <class T>
     std::string toString (T aNumber)
     {
-        std::ostringstream myOs;
-        myOs << aNumber;
-        return myOs.str();
+        // integers without a stream, streams print bool and the char types differently
+        if constexpr (std::is_integral_v<T>
+                      && !std::is_same_v<T, bool>
+                      && !std::is_same_v<T, char>
+                      && !std::is_same_v<T, signed char>
+                      && !std::is_same_v<T, unsigned char>)
+        {
+            char myBuf[24];
+            return std::string(myBuf, std::to_chars(myBuf, myBuf + sizeof(myBuf), aNumber).ptr);
+        }
+        else
+        {
+            std::ostringstream myOs;
+            myOs << aNumber;
+            return myOs.str();
+        }
     }
 
     template <class T>
@@ -235,10 +276,17 @@ namespace ulxr
     std::string getLastErrorString(unsigned errornum);
 
     /** Enables pretty-print of xml repsponses for better readability
+    * This is the default for xml which is generated without explicit
+    * \c XmlWriterOptions.
     * @param  pretty   true: add spaces and linefeeds for better readability
     */
     void enableXmlPrettyPrint(bool pretty);
 
+    /** Determines if pretty-print of xml repsponses is enabled.
+    * @return true if spaces and linefeeds are added
+    */
+    bool isXmlPrettyPrint();
+
     /** Gets a string with the line feed for an xml response
     * @return empty if pretty-print disabled
     * @return string for a regular line feed otherwise
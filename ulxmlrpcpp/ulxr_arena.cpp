@@ -0,0 +1,91 @@
+/***************************************************************************
+            ulxr_arena.cpp  -  memory region for parsed values
+                             -------------------
+    begin                : Sat Oct 17 2026
+    copyright            : (C) 2026 by the ulxmlrpcpp developers
+
+    $Id$
+
+ ***************************************************************************/
+
+/**************************************************************************
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ *
+ ***************************************************************************/
+
+
+
+#include <ulxmlrpcpp/ulxmlrpcpp.h>
+
+#include <ulxmlrpcpp/ulxr_arena.h>
+
+
+namespace ulxr {
+
+
+    ValueArena::ValueArena(std::size_t block_size)
+        : buffer(block_size, std::pmr::new_delete_resource())
+        , refs(1)
+    {
+    }
+
+
+    ValueArena::~ValueArena()
+    {
+    }
+
+
+    void ValueArena::addRef()
+    {
+        refs.fetch_add(1, std::memory_order_relaxed);
+    }
+
+
+    void ValueArena::release()
+    {
+        if (refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            delete this;
+    }
+
+
+    void ValueArena::destroy(ValueBase *node)
+    {
+        char *mem = static_cast<char*>(dynamic_cast<void*>(node)) - NodeOffset;
+        ValueArena *arena = *reinterpret_cast<ValueArena**>(mem);
+        node->~ValueBase();
+        arena->release();
+    }
+
+
+    void *ValueArena::do_allocate(std::size_t bytes, std::size_t alignment)
+    {
+        return buffer.allocate(bytes, alignment);
+    }
+
+
+    void ValueArena::do_deallocate(void * /* p */, std::size_t /* bytes */, std::size_t /* alignment */)
+    {
+        // memory is returned when the arena is destroyed
+    }
+
+
+    bool ValueArena::do_is_equal(const std::pmr::memory_resource &other) const noexcept
+    {
+        return this == &other;
+    }
+
+
+}  // namespace ulxr
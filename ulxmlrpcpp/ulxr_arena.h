@@ -0,0 +1,120 @@
+/***************************************************************************
+            ulxr_arena.h  -  memory region for parsed values
+                             -------------------
+    begin                : Sat Oct 17 2026
+    copyright            : (C) 2026 by the ulxmlrpcpp developers
+
+    $Id$
+
+ ***************************************************************************/
+
+/**************************************************************************
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ *
+ ***************************************************************************/
+
+#ifndef ULXR_ARENA_H
+#define ULXR_ARENA_H
+
+#include <ulxmlrpcpp/ulxmlrpcpp.h>
+#include <ulxmlrpcpp/ulxr_value.h>
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <memory_resource>
+
+
+namespace ulxr {
+
+
+    /** Memory region for the values of a parsed call or response.
+      * All nodes of a tree and the storage of their members are carved
+      * out of a few large blocks which are returned in one go when the
+      * last node is destroyed. Each node holds a reference to the arena,
+      * so the tree may outlive the parser which created it.
+      *
+      * Nodes inside an arena are never modified after parsing: handing out
+      * a non-const reference moves the content to the heap first.
+      * An arena is not thread safe and must only be filled by one parser.
+      * @ingroup grp_ulxr_parser
+      */
+    class  ValueArena : public std::pmr::memory_resource
+    {
+    public:
+
+        /** Creates an empty arena which is referenced once.
+          * @param  block_size  size of the first memory block
+          */
+        explicit ValueArena(std::size_t block_size = 16384);
+
+        /** Adds a reference to the arena.
+          */
+        void addRef();
+
+        /** Drops a reference and destroys the arena if it was the last one.
+          */
+        void release();
+
+        /** Creates a node inside the arena.
+          * @param  args   arguments for the constructor of the node
+          * @return pointer to the node, owned by the Value taking it over
+          */
+        template <class T, class... Args>
+        T *create(Args&&... args)
+        {
+            void *mem = allocate(NodeOffset + sizeof(T), alignof(std::max_align_t));
+            *static_cast<ValueArena**>(mem) = this;
+            T *node = new (static_cast<char*>(mem) + NodeOffset)
+                          T(static_cast<std::pmr::memory_resource*>(this), std::forward<Args>(args)...);
+            node->inArena = true;
+            addRef();
+            return node;
+        }
+
+        /** Destroys a node created by create() and drops its reference
+          * to the arena.
+          * @param  node  the node to destroy
+          */
+        static void destroy(ValueBase *node);
+
+    protected:
+
+        virtual void *do_allocate(std::size_t bytes, std::size_t alignment);
+
+        virtual void do_deallocate(void *p, std::size_t bytes, std::size_t alignment);
+
+        virtual bool do_is_equal(const std::pmr::memory_resource &other) const noexcept;
+
+    private:
+
+        enum { NodeOffset = alignof(std::max_align_t) };  // room for the owner in front of a node
+
+        std::pmr::monotonic_buffer_resource  buffer;
+        std::atomic<unsigned>                refs;
+
+        virtual ~ValueArena();
+
+        ValueArena(const ValueArena&); // forbid this
+        ValueArena& operator= (const ValueArena&);
+    };
+
+
+}  // namespace ulxr
+
+
+#endif // ULXR_ARENA_H
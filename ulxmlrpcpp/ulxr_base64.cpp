@@ -0,0 +1,485 @@
+/***************************************************************************
+            ulxr_base64.cpp  -  base64 encoder and decoder
+                             -------------------
+    begin                : Sat Oct 17 2026
+    copyright            : (C) 2026 by the ulxmlrpcpp developers
+
+    $Id$
+
+ ***************************************************************************/
+
+/**************************************************************************
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ *
+ ***************************************************************************/
+
+
+
+#include <ulxmlrpcpp/ulxmlrpcpp.h>
+
+#include <atomic>
+#include <cstring>
+
+#include <ulxmlrpcpp/ulxr_base64.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ULXR_BASE64_X86
+#include <immintrin.h>
+#endif
+
+
+namespace ulxr {
+
+
+    namespace
+    {
+
+        const unsigned LineBytes = 48;  // 64 characters per line like OpenSSL
+
+        const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+
+        struct DecodeTable
+        {
+            signed char value[256];  // -1 for characters outside the alphabet
+
+            DecodeTable()
+            {
+                std::memset(value, -1, sizeof(value));
+                for (int i = 0; i < 64; ++i)
+                    value[static_cast<unsigned char>(alphabet[i])] = i;
+            }
+        };
+
+        const DecodeTable decodeTable;
+
+
+        inline bool isBlank(char c)
+        {
+            return c == '\n' || c == '\r' || c == ' ' || c == '\t';
+        }
+
+
+        /* The vector kernels convert as much as they can and leave the rest
+           to the scalar code. The encoders read at most "readable" bytes and
+           return the number of bytes consumed, the decoders stop in front of
+           the first block with a character outside the alphabet and return
+           the number of characters consumed. */
+
+        std::size_t encodeNone(const unsigned char *, std::size_t, std::size_t, char *)
+        {
+            return 0;
+        }
+
+
+        std::size_t decodeNone(const char *, std::size_t, unsigned char *)
+        {
+            return 0;
+        }
+
+
+#ifdef ULXR_BASE64_X86
+
+        __attribute__((target("ssse3")))
+        std::size_t encodeSsse3(const unsigned char *src, std::size_t len, std::size_t readable, char *dst)
+        {
+            const __m128i spread = _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+            const __m128i shiftLUT = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                                   '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+                                                   '/' - 63, 'A', 0, 0);
+            std::size_t i = 0;
+            for (; len - i >= 12 && readable - i >= 16; i += 12, dst += 16)
+            {
+                __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+                in = _mm_shuffle_epi8(in, spread);
+
+                // split every 3 bytes into 4 indices of 6 bit
+                const __m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00));
+                const __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+                const __m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003f03f0));
+                const __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+                const __m128i indices = _mm_or_si128(t1, t3);
+
+                // map the ranges of the alphabet to an offset in shiftLUT
+                __m128i offset = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+                const __m128i less = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+                offset = _mm_or_si128(offset, _mm_and_si128(less, _mm_set1_epi8(13)));
+
+                const __m128i chars = _mm_add_epi8(_mm_shuffle_epi8(shiftLUT, offset), indices);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), chars);
+            }
+            return i;
+        }
+
+
+        __attribute__((target("ssse3")))
+        std::size_t decodeSsse3(const char *src, std::size_t len, unsigned char *dst)
+        {
+            std::size_t i = 0;
+            for (; len - i >= 16; i += 16, dst += 12)
+            {
+                const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+
+                const __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('A' - 1)),
+                                                    _mm_cmplt_epi8(c, _mm_set1_epi8('Z' + 1)));
+                const __m128i lower = _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('a' - 1)),
+                                                    _mm_cmplt_epi8(c, _mm_set1_epi8('z' + 1)));
+                const __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('0' - 1)),
+                                                    _mm_cmplt_epi8(c, _mm_set1_epi8('9' + 1)));
+                const __m128i plus  = _mm_cmpeq_epi8(c, _mm_set1_epi8('+'));
+                const __m128i slash = _mm_cmpeq_epi8(c, _mm_set1_epi8('/'));
+
+                const __m128i valid = _mm_or_si128(_mm_or_si128(upper, lower),
+                                                   _mm_or_si128(digit, _mm_or_si128(plus, slash)));
+                if (_mm_movemask_epi8(valid) != 0xffff)
+                    break;
+
+                __m128i shift = _mm_and_si128(upper, _mm_set1_epi8(-65));
+                shift = _mm_or_si128(shift, _mm_and_si128(lower, _mm_set1_epi8(-71)));
+                shift = _mm_or_si128(shift, _mm_and_si128(digit, _mm_set1_epi8(4)));
+                shift = _mm_or_si128(shift, _mm_and_si128(plus, _mm_set1_epi8(19)));
+                shift = _mm_or_si128(shift, _mm_and_si128(slash, _mm_set1_epi8(16)));
+                const __m128i values = _mm_add_epi8(c, shift);
+
+                // join 4 indices of 6 bit into 3 bytes
+                const __m128i pairs = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+                const __m128i quads = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+                const __m128i bytes = _mm_shuffle_epi8(quads, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8,
+                                                                            14, 13, 12, -1, -1, -1, -1));
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), bytes);
+                const int tail = _mm_cvtsi128_si32(_mm_srli_si128(bytes, 8));
+                std::memcpy(dst + 8, &tail, 4);
+            }
+            return i;
+        }
+
+
+        __attribute__((target("avx2")))
+        std::size_t encodeAvx2(const unsigned char *src, std::size_t len, std::size_t readable, char *dst)
+        {
+            const __m256i spread = _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+                                                    1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+            const __m256i shiftLUT = _mm256_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                                      '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+                                                      '/' - 63, 'A', 0, 0,
+                                                      'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                                      '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+                                                      '/' - 63, 'A', 0, 0);
+            std::size_t i = 0;
+            for (; len - i >= 24 && readable - i >= 28; i += 24, dst += 32)
+            {
+                const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+                const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 12));
+                __m256i in = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+                in = _mm256_shuffle_epi8(in, spread);
+
+                const __m256i t0 = _mm256_and_si256(in, _mm256_set1_epi32(0x0fc0fc00));
+                const __m256i t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+                const __m256i t2 = _mm256_and_si256(in, _mm256_set1_epi32(0x003f03f0));
+                const __m256i t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+                const __m256i indices = _mm256_or_si256(t1, t3);
+
+                __m256i offset = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+                const __m256i less = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+                offset = _mm256_or_si256(offset, _mm256_and_si256(less, _mm256_set1_epi8(13)));
+
+                const __m256i chars = _mm256_add_epi8(_mm256_shuffle_epi8(shiftLUT, offset), indices);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), chars);
+            }
+            return i + encodeSsse3(src + i, len - i, readable - i, dst);
+        }
+
+
+        __attribute__((target("avx2")))
+        std::size_t decodeAvx2(const char *src, std::size_t len, unsigned char *dst)
+        {
+            std::size_t i = 0;
+            for (; len - i >= 32; i += 32, dst += 24)
+            {
+                const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+
+                const __m256i upper = _mm256_andnot_si256(_mm256_cmpgt_epi8(c, _mm256_set1_epi8('Z')),
+                                                          _mm256_cmpgt_epi8(c, _mm256_set1_epi8('A' - 1)));
+                const __m256i lower = _mm256_andnot_si256(_mm256_cmpgt_epi8(c, _mm256_set1_epi8('z')),
+                                                          _mm256_cmpgt_epi8(c, _mm256_set1_epi8('a' - 1)));
+                const __m256i digit = _mm256_andnot_si256(_mm256_cmpgt_epi8(c, _mm256_set1_epi8('9')),
+                                                          _mm256_cmpgt_epi8(c, _mm256_set1_epi8('0' - 1)));
+                const __m256i plus  = _mm256_cmpeq_epi8(c, _mm256_set1_epi8('+'));
+                const __m256i slash = _mm256_cmpeq_epi8(c, _mm256_set1_epi8('/'));
+
+                const __m256i valid = _mm256_or_si256(_mm256_or_si256(upper, lower),
+                                                      _mm256_or_si256(digit, _mm256_or_si256(plus, slash)));
+                if (_mm256_movemask_epi8(valid) != -1)
+                    break;
+
+                __m256i shift = _mm256_and_si256(upper, _mm256_set1_epi8(-65));
+                shift = _mm256_or_si256(shift, _mm256_and_si256(lower, _mm256_set1_epi8(-71)));
+                shift = _mm256_or_si256(shift, _mm256_and_si256(digit, _mm256_set1_epi8(4)));
+                shift = _mm256_or_si256(shift, _mm256_and_si256(plus, _mm256_set1_epi8(19)));
+                shift = _mm256_or_si256(shift, _mm256_and_si256(slash, _mm256_set1_epi8(16)));
+                const __m256i values = _mm256_add_epi8(c, shift);
+
+                const __m256i pairs = _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+                const __m256i quads = _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011000));
+                const __m256i bytes = _mm256_shuffle_epi8(quads, _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8,
+                                                                                  14, 13, 12, -1, -1, -1, -1,
+                                                                                  2, 1, 0, 6, 5, 4, 10, 9, 8,
+                                                                                  14, 13, 12, -1, -1, -1, -1));
+                const __m256i packed = _mm256_permutevar8x32_epi32(bytes, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm256_castsi256_si128(packed));
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + 16), _mm256_extracti128_si256(packed, 1));
+            }
+            return i + decodeSsse3(src + i, len - i, dst);
+        }
+
+#endif // ULXR_BASE64_X86
+
+
+        typedef std::size_t (*EncodeKernel)(const unsigned char *, std::size_t, std::size_t, char *);
+        typedef std::size_t (*DecodeKernel)(const char *, std::size_t, unsigned char *);
+
+
+        bool isSupported(Base64Kernel kernel)
+        {
+#ifdef ULXR_BASE64_X86
+            if (kernel == Base64Avx2)
+                return __builtin_cpu_supports("avx2");
+
+            if (kernel == Base64Ssse3)
+                return __builtin_cpu_supports("ssse3");
+#endif
+            return kernel == Base64Scalar;
+        }
+
+
+        Base64Kernel detectKernel()
+        {
+            if (isSupported(Base64Avx2))
+                return Base64Avx2;
+
+            if (isSupported(Base64Ssse3))
+                return Base64Ssse3;
+
+            return Base64Scalar;
+        }
+
+
+        std::atomic<int> activeKernel(detectKernel());
+
+
+        EncodeKernel getEncodeKernel()
+        {
+#ifdef ULXR_BASE64_X86
+            switch (activeKernel.load(std::memory_order_relaxed))
+            {
+            case Base64Avx2:
+                return encodeAvx2;
+
+            case Base64Ssse3:
+                return encodeSsse3;
+            }
+#endif
+            return encodeNone;
+        }
+
+
+        DecodeKernel getDecodeKernel()
+        {
+#ifdef ULXR_BASE64_X86
+            switch (activeKernel.load(std::memory_order_relaxed))
+            {
+            case Base64Avx2:
+                return decodeAvx2;
+
+            case Base64Ssse3:
+                return decodeSsse3;
+            }
+#endif
+            return decodeNone;
+        }
+
+
+        char *encodeLine(EncodeKernel kernel, const unsigned char *src, std::size_t len,
+                         std::size_t readable, char *dst)
+        {
+            std::size_t i = kernel(src, len, readable, dst);
+            dst += i / 3 * 4;
+
+            for (; len - i >= 3; i += 3)
+            {
+                const unsigned triple = (src[i] << 16) | (src[i+1] << 8) | src[i+2];
+                *dst++ = alphabet[(triple >> 18) & 0x3f];
+                *dst++ = alphabet[(triple >> 12) & 0x3f];
+                *dst++ = alphabet[(triple >> 6) & 0x3f];
+                *dst++ = alphabet[triple & 0x3f];
+            }
+
+            if (len - i == 1)
+            {
+                *dst++ = alphabet[src[i] >> 2];
+                *dst++ = alphabet[(src[i] & 0x03) << 4];
+                *dst++ = '=';
+                *dst++ = '=';
+            }
+
+            else if (len - i == 2)
+            {
+                *dst++ = alphabet[src[i] >> 2];
+                *dst++ = alphabet[((src[i] & 0x03) << 4) | (src[i+1] >> 4)];
+                *dst++ = alphabet[(src[i+1] & 0x0f) << 2];
+                *dst++ = '=';
+            }
+
+            return dst;
+        }
+
+    }
+
+
+    std::size_t base64EncodedSize(std::size_t len, bool single_line)
+    {
+        const std::size_t chars = (len + 2) / 3 * 4;
+        if (single_line || len == 0)
+            return chars;
+
+        return chars + (len - 1) / LineBytes;  // line feeds between the lines
+    }
+
+
+    char *base64Encode(const unsigned char *src, std::size_t len, bool single_line, char *dst)
+    {
+        const EncodeKernel kernel = getEncodeKernel();
+        const std::size_t line = single_line ? len : LineBytes;
+
+        for (std::size_t pos = 0; pos < len; pos += line)
+        {
+            if (pos != 0)
+                *dst++ = '\n';
+
+            const std::size_t num = len - pos < line ? len - pos : line;
+            dst = encodeLine(kernel, src + pos, num, len - pos, dst);
+        }
+
+        return dst;
+    }
+
+
+    std::size_t base64DecodedMaxSize(std::size_t len)
+    {
+        return (len + 3) / 4 * 3;
+    }
+
+
+    bool base64Decode(const char *src, std::size_t len, bool single_line,
+                      unsigned char *dst, std::size_t &dst_len)
+    {
+        const DecodeKernel kernel = getDecodeKernel();
+        const char *end = src + len;
+        unsigned char *out = dst;
+        unsigned group = 0;  // accumulated bits of the current group
+        unsigned num = 0;    // number of characters in the current group
+        dst_len = 0;
+
+        if (single_line)
+            while (end != src && isBlank(end[-1]))   // the final line break
+                --end;
+
+        while (src != end)
+        {
+            if (num == 0)
+            {
+                const std::size_t used = kernel(src, end - src, out);
+                src += used;
+                out += used / 4 * 3;
+                if (src == end)
+                    break;
+            }
+
+            const char c = *src++;
+            const int value = decodeTable.value[static_cast<unsigned char>(c)];
+            if (value >= 0)
+            {
+                group = (group << 6) | value;
+                if (++num == 4)
+                {
+                    *out++ = (group >> 16) & 0xff;
+                    *out++ = (group >> 8) & 0xff;
+                    *out++ = group & 0xff;
+                    group = 0;
+                    num = 0;
+                }
+            }
+
+            else if (!single_line && isBlank(c))
+                continue;
+
+            else if (c == '=' && num >= 2)
+            {
+                const unsigned pads = 4 - num;   // including this one
+                for (unsigned seen = 1; seen < pads; )
+                {
+                    if (src == end)
+                        return single_line ? (dst_len = out - dst, true) : false;
+
+                    const char p = *src++;
+                    if (p == '=')
+                        ++seen;
+                    else if (single_line || !isBlank(p))
+                        return false;
+                }
+
+                group <<= 6 * pads;
+                *out++ = (group >> 16) & 0xff;
+                if (num == 3)
+                    *out++ = (group >> 8) & 0xff;
+                num = 0;
+
+                if (!single_line)   // nothing but white space may follow
+                    for (; src != end; ++src)
+                        if (!isBlank(*src))
+                            return false;
+                break;
+            }
+
+            else
+                return false;
+        }
+
+        if (num != 0 && !single_line)  // an incomplete group
+            return false;
+
+        dst_len = out - dst;
+        return true;
+    }
+
+
+    Base64Kernel getBase64Kernel()
+    {
+        return static_cast<Base64Kernel>(activeKernel.load(std::memory_order_relaxed));
+    }
+
+
+    bool setBase64Kernel(Base64Kernel kernel)
+    {
+        if (!isSupported(kernel))
+            return false;
+
+        activeKernel.store(kernel, std::memory_order_relaxed);
+        return true;
+    }
+
+
+}  // namespace ulxr
@@ -0,0 +1,101 @@
+/***************************************************************************
+            ulxr_base64.h  -  base64 encoder and decoder
+                             -------------------
+    begin                : Sat Oct 17 2026
+    copyright            : (C) 2026 by the ulxmlrpcpp developers
+
+    $Id$
+
+ ***************************************************************************/
+
+/**************************************************************************
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ *
+ ***************************************************************************/
+
+#ifndef ULXR_BASE64_H
+#define ULXR_BASE64_H
+
+#include <ulxmlrpcpp/ulxmlrpcpp.h>
+
+#include <cstddef>
+
+
+namespace ulxr {
+
+
+    /** Implementations of the inner loops of the base64 codec.
+      * The best one supported by the cpu is selected at startup.
+      */
+    enum Base64Kernel
+    {
+        Base64Scalar,    //!< portable byte by byte conversion
+        Base64Ssse3,     //!< 16 characters per step
+        Base64Avx2       //!< 32 characters per step
+    };
+
+    /** Returns the size of the encoded form of some data.
+      * @param  len          number of bytes to encode
+      * @param  single_line  false: a line feed after every 64 characters
+      * @return number of characters
+      */
+    std::size_t base64EncodedSize(std::size_t len, bool single_line);
+
+    /** Encodes data to base64 like toBase64() does.
+      * @param  src          the data to encode
+      * @param  len          number of bytes to encode
+      * @param  single_line  false: a line feed after every 64 characters
+      * @param  dst          buffer for base64EncodedSize() characters
+      * @return the end of the written characters
+      */
+    char *base64Encode(const unsigned char *src, std::size_t len, bool single_line, char *dst);
+
+    /** Returns the maximum size of the decoded form of some base64 text.
+      * @param  len   number of characters to decode
+      * @return number of bytes
+      */
+    std::size_t base64DecodedMaxSize(std::size_t len);
+
+    /** Decodes base64 text like fromBase64() does.
+      * In multi line mode white space is allowed anywhere, in single line
+      * mode only at the end. In single line mode text after the padding
+      * and an incomplete last group of characters are ignored.
+      * @param  src          the text to decode
+      * @param  len          number of characters to decode
+      * @param  single_line  true: the text is not wrapped
+      * @param  dst          buffer for base64DecodedMaxSize() bytes
+      * @param  dst_len      returns the number of decoded bytes
+      * @return false if the text is not valid base64
+      */
+    bool base64Decode(const char *src, std::size_t len, bool single_line,
+                      unsigned char *dst, std::size_t &dst_len);
+
+    /** Returns the kernel which is currently used.
+      * @return the kernel
+      */
+    Base64Kernel getBase64Kernel();
+
+    /** Selects the kernel to use, mainly for testing and benchmarking.
+      * @param  kernel  the desired kernel
+      * @return false if the cpu does not support this kernel
+      */
+    bool setBase64Kernel(Base64Kernel kernel);
+
+
+}  // namespace ulxr
+
+
+#endif // ULXR_BASE64_H
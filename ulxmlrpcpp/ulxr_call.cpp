@@ -38,6 +38,8 @@
 #include <ulxmlrpcpp/ulxr_call.h>
 #include <ulxmlrpcpp/ulxr_except.h>
 
+#include <utility>
+
 namespace ulxr {
 
 
@@ -52,11 +54,41 @@ namespace ulxr {
     }
 
 
+    MethodCall::MethodCall(const MethodCall &other)
+        : methodname(other.methodname)
+        , params(other.params)
+    {
+    }
+
+
+    MethodCall::MethodCall(MethodCall &&other)
+        : methodname(std::move(other.methodname))
+        , params(std::move(other.params))
+    {
+    }
+
+
     MethodCall::~MethodCall()
     {
     }
 
 
+    MethodCall& MethodCall::operator= (const MethodCall &other)
+    {
+        methodname = other.methodname;
+        params = other.params;
+        return *this;
+    }
+
+
+    MethodCall& MethodCall::operator= (MethodCall &&other)
+    {
+        methodname = std::move(other.methodname);
+        params = std::move(other.params);
+        return *this;
+    }
+
+
     MethodCall::MethodCall(const std::string &name)
     {
         methodname = name;
@@ -70,6 +102,13 @@ namespace ulxr {
     }
 
 
+    MethodCall&  /**/ MethodCall::addParam (Value &&val)
+    {
+        params.push_back(std::move(val));
+        return *this;
+    }
+
+
     MethodCall&  /**/ MethodCall::setParam (const Value &val)
     {
         clear();
@@ -77,6 +116,13 @@ namespace ulxr {
     }
 
 
+    MethodCall&  /**/ MethodCall::setParam (Value &&val)
+    {
+        clear();
+        return addParam(std::move(val));
+    }
+
+
     MethodCall&  /**/ MethodCall::setParam (unsigned ind, const Value &val)
     {
         if (ind < params.size() )
@@ -90,6 +136,19 @@ namespace ulxr {
     }
 
 
+    MethodCall&  /**/ MethodCall::setParam (unsigned ind, Value &&val)
+    {
+        if (ind < params.size() )
+        {
+            params[ind] = std::move(val);
+            return *this;
+        }
+
+        throw ParameterException(InvalidMethodParameterError,
+                                 "MethodCall::setParam: Parameter index " + toString(ind) + " in " + getSignature() + " method is out-of-range");
+    }
+
+
 
     std::string MethodCall::getSignature(bool name_braces) const
     {
@@ -112,26 +171,83 @@ namespace ulxr {
 
     std::string MethodCall::getXml(int indent) const
     {
-        std::string ind = getXmlIndent(indent);
-        std::string ind1 = getXmlIndent(indent+1);
-        std::string ind2 = getXmlIndent(indent+2);
-        std::string s = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>" + getXmlLinefeed();
-        s += ind + "<methodCall>" + getXmlLinefeed();
-        s += ind1 + "<methodName>"+methodname+"</methodName>" + getXmlLinefeed();
+        return getXml(XmlWriterOptions(), indent);
+    }
+
+
+    std::string MethodCall::getXml(const XmlWriterOptions &options, int indent) const
+    {
+        std::string s;
+        s.reserve(getXmlSize(options, indent));
+        XmlSink sink(s, options);
+        serialize(sink, indent);
+        return s;
+    }
+
 
-        s += ind1 + "<params>" + getXmlLinefeed();
+    void MethodCall::serialize(XmlSink &sink, int indent) const
+    {
+        if (sink.getOptions().hasXmlDeclaration())
+        {
+            sink.append("<?xml version=\"1.0\" encoding=\"UTF-8\"?>");
+            sink.appendLinefeed();
+        }
+        sink.appendIndent(indent);
+        sink.append("<methodCall>");
+        sink.appendLinefeed();
+        sink.appendIndent(indent+1);
+        sink.append("<methodName>");
+        sink.append(methodname);
+        sink.append("</methodName>");
+        sink.appendLinefeed();
+
+        sink.appendIndent(indent+1);
+        sink.append("<params>");
+        sink.appendLinefeed();
 
         for (std::vector<Value>::const_iterator
                 it = params.begin(); it != params.end(); ++it)
         {
-            s += ind2 + "<param>" + getXmlLinefeed();
-            s += (*it).getXml(indent+3) + getXmlLinefeed();
-            s += ind2 + "</param>" + getXmlLinefeed();
+            sink.appendIndent(indent+2);
+            sink.append("<param>");
+            sink.appendLinefeed();
+            (*it).serialize(sink, indent+3);
+            sink.appendLinefeed();
+            sink.appendIndent(indent+2);
+            sink.append("</param>");
+            sink.appendLinefeed();
         }
 
-        s += ind1 + "</params>" + getXmlLinefeed();
-        s += ind + "</methodCall>";
-        return s;
+        sink.appendIndent(indent+1);
+        sink.append("</params>");
+        sink.appendLinefeed();
+        sink.appendIndent(indent);
+        sink.append("</methodCall>");
+    }
+
+
+    std::size_t MethodCall::getXmlSize(int indent) const
+    {
+        return getXmlSize(XmlWriterOptions(), indent);
+    }
+
+
+    std::size_t MethodCall::getXmlSize(const XmlWriterOptions &options, int indent) const
+    {
+        const std::size_t lf = options.getLinefeedSize();
+        const std::size_t param = options.getIndentSize(indent+2) * 2 + lf * 3
+                                + sizeof("<param></param>") - 1;
+        std::size_t size = options.getIndentSize(indent) * 2 + options.getIndentSize(indent+1) * 3
+                         + lf * 4 + methodname.length()
+                         + sizeof("<methodCall><methodName></methodName><params></params></methodCall>") - 1;
+        if (options.hasXmlDeclaration())
+            size += sizeof("<?xml version=\"1.0\" encoding=\"UTF-8\"?>") - 1 + lf;
+
+        for (std::vector<Value>::const_iterator
+                it = params.begin(); it != params.end(); ++it)
+            size += param + (*it).getXmlSize(options, indent+3);
+
+        return size;
     }
 
 
@@ -58,10 +58,30 @@ namespace ulxr {
           */
         MethodCall(const std::string &name);
 
+        /** Creates a method call as duplicate of another method call.
+          * @param  other  the source call
+          */
+        MethodCall(const MethodCall &other);
+
+        /** Creates a method call by taking over name and parameters of another call.
+          * @param  other  the source call, without parameters afterwards
+          */
+        MethodCall(MethodCall &&other);
+
         /** Destroys a method call.
           */
         virtual ~MethodCall();
 
+        /** Copies name and parameters of another method call.
+          * @param  other  the source call
+          */
+        MethodCall &operator= (const MethodCall &other);
+
+        /** Takes over name and parameters of another method call.
+          * @param  other  the source call, without parameters afterwards
+          */
+        MethodCall &operator= (MethodCall &&other);
+
         /** Returns the signature of this call.
           * The signature consists of all type names in this call delimited by
           * commas. Elements of arrays are surrounded by braces. Structure elements
@@ -89,22 +109,66 @@ namespace ulxr {
           */
         virtual std::string getXml(int indent = 0) const;
 
+        /** Returns the call as xml string.
+          * @param  options  settings for the generated xml
+          * @param  indent   current indentation level
+          * @return  The xml content
+          */
+        std::string getXml(const XmlWriterOptions &options, int indent = 0) const;
+
+        /** Writes the call as xml to a sink.
+          * The method call is converted to an xml text like \c getXml() does.
+          * @param  sink     receives the xml content
+          * @param  indent   current indentation level
+          */
+        virtual void serialize(XmlSink &sink, int indent = 0) const;
+
+        /** Returns the size of the xml which \c serialize() writes
+          * with the process wide settings.
+          * @param  indent   current indentation level
+          * @return  number of characters
+          */
+        std::size_t getXmlSize(int indent = 0) const;
+
+        /** Returns the size of the xml which \c serialize() writes.
+          * @param  options  settings for the generated xml
+          * @param  indent   current indentation level
+          * @return  number of characters
+          */
+        virtual std::size_t getXmlSize(const XmlWriterOptions &options, int indent = 0) const;
+
         /** Adds another parameter to this call.
           * @param  val   the "value" of this parameter
           */
         MethodCall& addParam (const Value &val);
 
+        /** Adds another parameter to this call by taking over its content.
+          * @param  val   the "value" of this parameter
+          */
+        MethodCall& addParam (Value &&val);
+
         /** Sets the parameter to this call.
           * The previous parameraters are removed.
           * @param  val   the "value" of this parameter
           */
         MethodCall& setParam (const Value &val);
 
+        /** Sets the parameter to this call by taking over its content.
+          * The previous parameraters are removed.
+          * @param  val   the "value" of this parameter
+          */
+        MethodCall& setParam (Value &&val);
+
         /** Sets the parameter for the goven index to this call.
           * @param  val   the "value" of this parameter
           */
         MethodCall& setParam (unsigned ind, const Value &val);
 
+        /** Sets the parameter for the given index by taking over its content.
+          * @param  val   the "value" of this parameter
+          */
+        MethodCall& setParam (unsigned ind, Value &&val);
+
         /** Returns one of the parameters of this call.
           * @param  ind   index of this value
           * @return   the value of this parameter
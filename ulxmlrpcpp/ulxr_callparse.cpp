@@ -33,8 +33,8 @@
 //#define ULXR_SHOW_WRITE
 //#define ULXR_SHOW_XML
 
-#include <cstring>
 #include <memory>
+#include <utility>
 
 
 #include <ulxmlrpcpp/ulxmlrpcpp.h>
@@ -63,39 +63,40 @@ namespace ulxr {
                    << name
                   );
 
-        switch(states.top()->getParserState() )
+        const Tag tag = getTag(name);
+        switch(getTopValueState()->getParserState() )
         {
         case eNone:
-            if (strcmp(name, "methodCall") == 0)
+            if (tag == eTagMethodCall)
             {
                 setComplete(false);
-                states.push(new ValueState(eMethodCall));
+                pushState(eMethodCall);
             }
             else
                 return false;
             break;
 
         case eMethodCall:
-            if (strcmp(name, "methodName") == 0)
-                states.push(new ValueState(eMethodName));
+            if (tag == eTagMethodName)
+                pushState(eMethodName);
 
-            else if (strcmp(name, "params") == 0)
-                states.push(new ValueState(eParams));
+            else if (tag == eTagParams)
+                pushState(eParams);
 
             else
                 return false;
             break;
 
         case eParams:
-            if (strcmp(name, "param") == 0)
-                states.push(new ValueState(eParam));
+            if (tag == eTagParam)
+                pushState(eParam);
             else
                 return false;
             break;
 
         case eParam:
-            if(strcmp(name, "value") == 0)
-                states.push(new ValueState(eValue));
+            if(tag == eTagValue)
+                pushState(eValue);
             else
                 return false;
             break;
@@ -119,43 +120,41 @@ namespace ulxr {
     {
         ULXR_TRACE("MethodCallParser::testEndElement(const XML_Char*)");
 
-        if (states.size() <= 1)
+        if (numStates() <= 1)
             throw RuntimeException(ApplicationError, "abnormal program behaviour: MethodCallParser::testEndElement() had no states left");
 
-        std::unique_ptr<ValueState> curr(getTopValueState());
-        states.pop();
+        ValueState *curr = getTopValueState();
 
 //   ULXR_TRACE("\n  current data: <"
-//              << curr->getCharData() << ">");
+//              << getCharData(*curr) << ">");
 
         switch(curr->getParserState() )
         {
         case eMethodName:
-            assertEndElement(name, "methodName");
-            methodcall.setMethodName(curr->getCharData());
+            assertEndElement(name, eTagMethodName);
+            methodcall.setMethodName(getCharData(*curr));
             break;
 
         case eMethodCall:
-            assertEndElement(name, "methodCall");
+            assertEndElement(name, eTagMethodCall);
             setComplete(true);
             break;
 
         case eParams:
-            assertEndElement(name, "params");
+            assertEndElement(name, eTagParams);
             break;
 
         case eParam:
-            assertEndElement(name, "param");
-            if (curr->getValue() != 0)
-                methodcall.addParam(*curr->getValue());
-            delete curr->getValue();
+            assertEndElement(name, eTagParam);
+            if (curr->hasValue())
+                methodcall.addParam(curr->releaseValue());
             break;
 
         default:
-            states.push(curr.release());  // put back, someone else will process
-            return false;
+            return false;   // someone else will process
         }
 
+        popState();
         return true;
     }
 
@@ -34,6 +34,9 @@
 
 #include <cstring>
 #include <memory>
+#include <vector>
+#include <algorithm>
+#include <climits>
 #include <ctype.h>
 #include <cstdlib>
 #include <cerrno>
@@ -41,6 +44,7 @@
 #include <netdb.h>
 #include <sys/time.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <csignal>
 #include <cstdio>
 
@@ -94,79 +98,126 @@ namespace ulxr
     }
 
 
+    size_t Connection::low_level_writev(const iovec *iov, int count)
+    {
+        ULXR_TRACE("Connection::low_level_writev " << count);
+        return ::writev(fd_handle, iov, count);
+    }
+
+
     void Connection::write(char const *buff, long len)
     {
         ULXR_TRACE("Connection::write " << len);
-        ULXR_DWRITE_WRITE(buff, len);
-        ULXR_DOUT_WRITE("");
 
-        long written;
-
-        if (!buff || !isOpen())
+        if (!buff || len < 0)
             throw RuntimeException(ApplicationError, "Precondition failed for write() call");
 
-        if (len == 0)
-            return;
+        iovec piece;
+        piece.iov_base = const_cast<char*>(buff);
+        piece.iov_len = len;
+        write(&piece, 1);
+    }
+
 
+    void Connection::waitWritable()
+    {
         fd_set wfd;
         timeval wait;
 
-        while (buff != 0 && len > 0)
+        FD_ZERO(&wfd);
+        FD_SET((unsigned) fd_handle, &wfd);
+        int ready;
+
+        const unsigned myTimeoutSec = getTimeout();
+        wait.tv_sec = myTimeoutSec;
+        wait.tv_usec = 0;
+
+        while((ready = select(fd_handle+1, 0, &wfd, 0, &wait)) < 0)
         {
-            FD_ZERO(&wfd);
-            FD_SET((unsigned) fd_handle, &wfd);
-            int ready;
+            if(errno == EINTR || errno == EAGAIN)
+            {
+                // signal received, continue select
+                wait.tv_sec = myTimeoutSec;
+                wait.tv_usec = 0;
+                continue;
+            }
+            else
+                throw ConnectionException(SystemError, "Could not perform select() call: " + getErrorString(getLastError()), 500);
+        }
+        if(ready == 0)
+            throw ConnectionException(SystemError, "Timeout while attempting to write (after " + toString(myTimeoutSec) + "seconds.", 500);
+    }
 
-            const unsigned myTimeoutSec = getTimeout();
-            wait.tv_sec = myTimeoutSec;
-            wait.tv_usec = 0;
 
-            while((ready = select(fd_handle+1, 0, &wfd, 0, &wait)) < 0)
+    void Connection::write(const iovec *iov, int count)
+    {
+        ULXR_TRACE("Connection::write iovec " << count);
+
+        if (!iov || count < 0 || !isOpen())
+            throw RuntimeException(ApplicationError, "Precondition failed for write() call");
+
+#ifdef IOV_MAX
+        const std::size_t max_pieces = IOV_MAX;
+#else
+        const std::size_t max_pieces = 16;
+#endif
+
+        // a copy which is advanced over what is already written
+        std::vector<iovec> pieces;
+        pieces.reserve(count);
+        for (int i = 0; i < count; ++i)
+        {
+            ULXR_DWRITE_WRITE((const char*) iov[i].iov_base, iov[i].iov_len);
+            if (iov[i].iov_len != 0)
+                pieces.push_back(iov[i]);
+        }
+        ULXR_DOUT_WRITE("");
+
+        std::size_t first = 0;
+        while (first < pieces.size())
+        {
+            waitWritable();
+
+            const std::size_t num = std::min(pieces.size() - first, max_pieces);
+            long written;
+            if ( (written = low_level_writev(&pieces[first], num)) < 0)
             {
-                if(errno == EINTR || errno == EAGAIN)
+                switch(getLastError())
                 {
-                    // signal received, continue select
-                    wait.tv_sec = myTimeoutSec;
-                    wait.tv_usec = 0;
+                case EAGAIN:
+                case EINTR:
+                    errno = 0;
                     continue;
+
+                case EPIPE:
+                    close();
+                    throw ConnectionException(TransportError,
+                                              "Attempt to write to a connection already closed by the peer", 500);
+                /*break; */
+
+                default:
+                    throw ConnectionException(SystemError,
+                                              "Could not perform low_level_write() call: " + getErrorString(getLastError()), 500);
+
                 }
-                else
-                    throw ConnectionException(SystemError, "Could not perform select() call: " + getErrorString(getLastError()), 500);
             }
-            if(ready == 0)
-                throw ConnectionException(SystemError, "Timeout while attempting to write (after " + toString(myTimeoutSec) + "seconds.", 500);
 
-            if(FD_ISSET(fd_handle, &wfd))
+            while (written > 0)
             {
-                if ( (written = low_level_write(buff, len)) < 0)
+                iovec &piece = pieces[first];
+                if ((std::size_t) written >= piece.iov_len)
                 {
-                    switch(getLastError())
-                    {
-                    case EAGAIN:
-                    case EINTR:
-                        errno = 0;
-                        continue;
-
-                    case EPIPE:
-                        close();
-                        throw ConnectionException(TransportError,
-                                                  "Attempt to write to a connection already closed by the peer", 500);
-                    /*break; */
-
-                    default:
-                        throw ConnectionException(SystemError,
-                                                  "Could not perform low_level_write() call: " + getErrorString(getLastError()), 500);
-
-                    }
+                    written -= piece.iov_len;
+                    ++first;
                 }
                 else
                 {
-                    buff += written;
-                    len -= written;
+                    piece.iov_base = (char*) piece.iov_base + written;
+                    piece.iov_len -= written;
+                    written = 0;
                 }
             }
         }
-
     }
 
 
@@ -319,6 +370,43 @@ namespace ulxr
     }
 
 
+    bool Connection::waitForInput(unsigned timeout_sec)
+    {
+        ULXR_TRACE("Connection::waitForInput " << timeout_sec);
+
+        if (!isOpen())
+            throw RuntimeException(ApplicationError, "Precondition failed for waitForInput() call");
+
+        if (hasPendingInput())
+            return true;
+
+        fd_set rfd;
+        FD_ZERO(&rfd);
+        FD_SET((unsigned) fd_handle, &rfd);
+
+        timeval wait;
+        wait.tv_sec = timeout_sec;
+        wait.tv_usec = 0;
+        int ready;
+        while((ready = ::select(fd_handle+1, &rfd, 0, 0, &wait)) < 0)
+        {
+            if (errno == EINTR || errno == EAGAIN)
+            {
+                // signal received, continue select
+                FD_ZERO(&rfd);
+                FD_SET((unsigned) fd_handle, &rfd);
+                wait.tv_sec = timeout_sec;
+                wait.tv_usec = 0;
+                continue;
+            }
+            else
+                throw ConnectionException(SystemError, "Could not perform select() call: " + getErrorString(getLastError()), 500);
+        }
+
+        return ready > 0;
+    }
+
+
     void Connection::setHandle(int handle)
     {
         close();
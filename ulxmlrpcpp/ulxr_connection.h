@@ -32,6 +32,8 @@
 
 #include <ulxmlrpcpp/ulxmlrpcpp.h>
 
+#include <sys/uio.h>
+
 namespace ulxr {
 
     /** @brief A connection object to transport XML-RPC calls.
@@ -70,6 +72,14 @@ namespace ulxr {
           */
         virtual void write(char const *buff, long len);
 
+        /** Writes several pieces of data to the connection.
+          * The pieces are passed to the system in one call as far as possible,
+          * so for example a http header and its body leave in one segment.
+          * @param  iov    the pieces in the order to write
+          * @param  count  number of pieces
+          */
+        virtual void write(const iovec *iov, int count);
+
         /** Reads data from the connection.
           * @param  buff pointer to data buffer
           * @param  len  maimum number of bytes to read into buffer
@@ -77,6 +87,13 @@ namespace ulxr {
           */
         virtual size_t read(char *buff, long len);
 
+        /** Waits until data arrives or the peer closes the connection.
+          * Used for idle persistent connections.
+          * @param  timeout_sec  maximum time to wait, 0 only tests the current state
+          * @return true: the next read() does not block
+          */
+        bool waitForInput(unsigned timeout_sec);
+
         /** Opens the connection in rpc client mode.
           */
         virtual void open() = 0;
@@ -136,6 +153,13 @@ namespace ulxr {
           */
         virtual size_t low_level_write(char const *buff, long len);
 
+        /** Actually writes several pieces of data to the connection.
+          * @param  iov    the pieces in the order to write
+          * @param  count  number of pieces, at least one
+          * @return  result from api writev function
+          */
+        virtual size_t low_level_writev(const iovec *iov, int count);
+
         /** Reads data from the connection.
           * @param  buff pointer to data buffer
           * @param  len  maimum number of bytes to read into buffer
@@ -154,6 +178,10 @@ namespace ulxr {
           */
         void init();
 
+        /** Waits until data can be written without blocking.
+          */
+        void waitWritable();
+
     private:
         int                    fd_handle;
         unsigned               theRwTimeoutSec;
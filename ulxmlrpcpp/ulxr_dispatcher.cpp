@@ -35,6 +35,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <utility>
 
 #include <ulxmlrpcpp/ulxmlrpcpp.h>
 #include <ulxmlrpcpp/ulxr_dispatcher.h>
@@ -174,6 +175,8 @@ namespace ulxr {
     Dispatcher::Dispatcher (Protocol* prot)
     {
         protocol = prot;
+        arena_used = false;
+        native_used = false;
         setupSystemMethods();
     }
 
@@ -299,6 +302,14 @@ namespace ulxr {
     MethodCall Dispatcher::waitForCall(int _timeout)
     {
         ULXR_TRACE("waitForCall");
+        bool reused = protocol->isOpen() && protocol->isKeepAlive();
+        if (reused && !protocol->waitForInput(protocol->getKeepAliveTimeout()))
+        {
+            ULXR_TRACE("waitForCall closes idle connection");
+            protocol->closeConnection();
+            reused = false;
+        }
+
         if (!protocol->isOpen())
         {
             if (!protocol->accept(_timeout))
@@ -315,57 +326,74 @@ namespace ulxr {
         MethodCallParserBase *cpb = 0;
         ULXR_TRACE("waitForCall in XML");
         MethodCallParser *cp = new MethodCallParser();
+        cp->useArena(arena_used);
+        cp->useNativeParser(native_used);
         cpb = cp;
         parser.reset(cp);
 
         bool done = false;
+        bool received = false;
         long myRead;
-        while (!done && ((myRead = protocol->readRaw(buffer, sizeof(buffer))) > 0) )
+        try
         {
-            buff_ptr = buffer;
-            while (myRead > 0)
+            while (!done && ((myRead = protocol->readRaw(buffer, sizeof(buffer))) > 0) )
             {
-                Protocol::State state = protocol->connectionMachine(buff_ptr, myRead);
-                if (state == Protocol::ConnError)
-                    throw ConnectionException(TransportError, "network problem occured", 500);
-
-                else if (state == Protocol::ConnSwitchToBody)
+                received = true;
+                buff_ptr = buffer;
+                while (myRead > 0)
                 {
-                    if (!protocol->hasBytesToRead())
+                    Protocol::State state = protocol->connectionMachine(buff_ptr, myRead);
+                    if (state == Protocol::ConnError)
+                        throw ConnectionException(TransportError, "network problem occured", 500);
+
+                    else if (state == Protocol::ConnSwitchToBody)
                     {
+                        if (!protocol->hasBytesToRead())
+                        {
 #ifdef ULXR_SHOW_READ
-                        std::string super_data(buff_ptr, myRead);
-                        while ((myRead = protocol->readRaw(buffer, sizeof(buffer))) > 0)
-                            super_data.append(buffer, myRead);
-                        ULXR_DOUT_READ("superdata 1 start:\n"
-                                       << super_data
-                                       << "superdata 1 end:\n");
+                            std::string super_data(buff_ptr, myRead);
+                            while ((myRead = protocol->readRaw(buffer, sizeof(buffer))) > 0)
+                                super_data.append(buffer, myRead);
+                            ULXR_DOUT_READ("superdata 1 start:\n"
+                                           << super_data
+                                           << "superdata 1 end:\n");
 #endif
-                        throw ConnectionException(NotConformingError,  "Content-Length of message not available", 411);
+                            throw ConnectionException(NotConformingError,  "Content-Length of message not available", 411);
+                        }
                     }
-                }
 
-                else if (state == Protocol::ConnBody)
-                {
-                    ULXR_DOUT_XML(std::string(buff_ptr, myRead));
-                    if (!parser->parse(buff_ptr, myRead, done))
+                    else if (state == Protocol::ConnBody)
                     {
-                        ULXR_DOUT("errline: " << parser->getCurrentLineNumber());
-                        ULXR_DWRITE(buff_ptr, myRead);
-                        ULXR_DOUT("") ;
-
-                        throw XmlException(parser->mapToFaultCode(parser->getErrorCode()),
-                                           "Problem while parsing xml request",
-                                           parser->getCurrentLineNumber(),
-                                           parser->getErrorString(parser->getErrorCode()));
+                        ULXR_DOUT_XML(std::string(buff_ptr, myRead));
+                        if (!parser->parse(buff_ptr, myRead, done))
+                        {
+                            ULXR_DOUT("errline: " << parser->getCurrentLineNumber());
+                            ULXR_DWRITE(buff_ptr, myRead);
+                            ULXR_DOUT("") ;
+
+                            throw XmlException(parser->mapToFaultCode(parser->getErrorCode()),
+                                               "Problem while parsing xml request",
+                                               parser->getCurrentLineNumber(),
+                                               parser->getErrorString(parser->getErrorCode()));
+                        }
+                        myRead = 0;
                     }
-                    myRead = 0;
                 }
-            }
 
-            if (!protocol->hasBytesToRead())
+                if (!protocol->hasBytesToRead())
 //        || parser->isComplete())
-                done = true;
+                    done = true;
+            }
+        }
+        catch (ConnectionException &)
+        {
+            if (!reused || received)
+                throw;
+
+            // the client has closed its idle persistent connection
+            ULXR_TRACE("waitForCall: persistent connection closed by client");
+            protocol->closeConnection();
+            return waitForCall(_timeout);
         }
 
         ULXR_TRACE("waitForCall got " << cpb->getMethodCall().getXml());
@@ -572,7 +600,7 @@ namespace ulxr {
                 arr.addItem(RpcString((*it).first.method_name));
                 m_prev = (*it).first.method_name;
             }
-        return MethodResponse (arr);
+        return MethodResponse (std::move(arr));
     }
 
 
@@ -606,14 +634,14 @@ namespace ulxr {
                     sig.erase(0, pos+1);
                 }
                 sigarr.addItem(RpcString(sig));
-                ret_arr.addItem(sigarr);
+                ret_arr.addItem(std::move(sigarr));
             }
         }
 
         if (ret_arr.size() == 0)
             return MethodResponse (Integer(1));  // non-Array ==< no signatures
         else
-            return MethodResponse (ret_arr);
+            return MethodResponse (std::move(ret_arr));
     }
 
 
@@ -674,8 +702,8 @@ namespace ulxr {
         disp->getCapabilities(sysCap);
 
         Struct opStr;
-        opStr.addMember("faults_interop", sysCap);
-        return MethodResponse (opStr);
+        opStr.addMember("faults_interop", std::move(sysCap));
+        return MethodResponse (std::move(opStr));
     }
 
 
@@ -690,6 +718,30 @@ namespace ulxr {
         protocol = prot;
     }
 
+
+    void Dispatcher::useArena(bool enable)
+    {
+        arena_used = enable;
+    }
+
+
+    bool Dispatcher::isArenaUsed() const
+    {
+        return arena_used;
+    }
+
+
+    void Dispatcher::useNativeParser(bool enable)
+    {
+        native_used = enable;
+    }
+
+
+    bool Dispatcher::isNativeParserUsed() const
+    {
+        return native_used;
+    }
+
     namespace hidden {
 
         MethodWrapperBase::~MethodWrapperBase()
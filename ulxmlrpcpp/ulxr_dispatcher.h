@@ -281,6 +281,9 @@ namespace ulxr {
                         const std::string &help = "");
 
         /** Waits for an incoming method call.
+          * A persistent connection which stays idle longer than the keep-alive
+          * timeout or which the client closes is dropped and the next
+          * connection is accepted.
           * @param timeout the timeout value [sec] (0 - no timeout)
           * @return the complete call data
           */
@@ -337,6 +340,29 @@ namespace ulxr {
           */
         void removeMethod(const std::string &name);
 
+        /** Selects if incoming calls are parsed into a ValueArena.
+          * The parameters of a call are then freed in one go when the
+          * last copy of the MethodCall is destroyed.
+          * @param  enable  true: use an arena for each call
+          */
+        void useArena(bool enable);
+
+        /** Tests if incoming calls are parsed into a ValueArena.
+          * @return true in arena mode
+          */
+        bool isArenaUsed() const;
+
+        /** Selects if incoming calls are read by the native \c PullParser.
+          * Expat is used by default.
+          * @param  enable  true: use the native parser
+          */
+        void useNativeParser(bool enable);
+
+        /** Tests if incoming calls are read by the native \c PullParser.
+          * @return true if the native parser is used
+          */
+        bool isNativeParserUsed() const;
+
     protected:
 
         /** Adds a methode descriptor to the dispatcher.
@@ -405,6 +431,8 @@ namespace ulxr {
 
         MethodCallMap             methodcalls;
         Protocol                 *protocol;
+        bool                      arena_used;
+        bool                      native_used;
     };
 
 
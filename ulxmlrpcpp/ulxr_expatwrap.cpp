@@ -38,12 +38,17 @@ namespace ulxr {
 
     ExpatWrapper::ExpatWrapper(bool createParser)
         : XmlParserBase()
+        , expatParser(0)
     {
         if (createParser)
-        {
-            expatParser = ::XML_ParserCreate(0);
-            setHandler();
-        }
+            createExpatParser();
+    }
+
+
+    void ExpatWrapper::createExpatParser()
+    {
+        expatParser = ::XML_ParserCreate(0);
+        setHandler();
     }
 
 
@@ -64,6 +69,9 @@ namespace ulxr {
 
     void ExpatWrapper::resetParser()
     {
+        if (expatParser == 0)
+            return;
+
         ::XML_ParserReset(expatParser, 0);
         setHandler();
     }
@@ -132,12 +140,18 @@ namespace ulxr {
 
     int  ExpatWrapper::parse(const char* buffer, int len, int isFinal)
     {
+        if (expatParser == 0)
+            createExpatParser();
+
         return ::XML_Parse(expatParser, buffer, len, isFinal);
     }
 
 
     unsigned  ExpatWrapper::getErrorCode() const
     {
+        if (expatParser == 0)
+            return XML_ERROR_NONE;
+
         return ::XML_GetErrorCode(expatParser);
     }
 
@@ -150,6 +164,9 @@ namespace ulxr {
 
     int  ExpatWrapper::getCurrentLineNumber() const
     {
+        if (expatParser == 0)
+            return 0;
+
         return ::XML_GetCurrentLineNumber(expatParser);
     }
 
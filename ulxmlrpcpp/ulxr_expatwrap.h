@@ -45,7 +45,8 @@ namespace ulxr {
     public:
 
         /** Constructs an expat  parser.
-          * @param createParser  create a new parser instance
+          * @param createParser  create a new parser instance now instead of
+          *                      when parsing starts
           */
         ExpatWrapper(bool createParser=true);
 
@@ -138,6 +139,12 @@ namespace ulxr {
           */
         void resetParser();
 
+        /** Creates the expat parser.
+          * Without \c createParser in the constructor this happens
+          * with the first call to \c parse().
+          */
+        void createExpatParser();
+
     private:
 
         /** Sets the callback handlers.
@@ -40,6 +40,11 @@
 #include <sys/stat.h>
 
 #include <cstring>
+#include <strings.h>
+#include <cctype>
+#include <algorithm>
+#include <charconv>
+#include <string_view>
 
 #include <ulxmlrpcpp/ulxmlrpcpp.h>
 #include <ulxmlrpcpp/ulxr_http_protocol.h>
@@ -47,17 +52,53 @@
 #include <ulxmlrpcpp/ulxr_except.h>
 #include <ulxmlrpcpp/ulxr_response.h>
 #include <ulxmlrpcpp/ulxr_call.h>
+#include <ulxmlrpcpp/ulxr_xmlsink.h>
 
 namespace ulxr
 {
 
     struct HttpProtocol::PImpl
     {
+        /** A field of the header, the parts are offsets into \c header_block.
+          */
+        struct HeaderField
+        {
+            std::size_t  name;
+            std::size_t  name_len;
+            std::size_t  value;
+            std::size_t  value_len;
+        };
+
+        /** Tests the name of a header field.
+          * @param  field  the field
+          * @param  name   the name to compare with, case insensitive
+          * @return true if the field has this name
+          */
+        bool hasName(const HeaderField &field, std::string_view name) const
+        {
+            return field.name_len == name.length()
+                   && strncasecmp(&header_block[field.name], name.data(), name.length()) == 0;
+        }
+
+        /** Looks up a header field.
+          * @param  name   the name of the field, case insensitive
+          * @return the first field with this name, 0 if not available
+          */
+        const HeaderField *findField(std::string_view name) const
+        {
+            for (std::size_t i = 0; i < header_fields.size(); ++i)
+                if (hasName(header_fields[i], name))
+                    return &header_fields[i];
+            return 0;
+        }
+
         std::string    proxy_user;
         std::string    proxy_pass;
         std::string    useragent;
         std::string    header_firstline;
-        std::string    header_buffer;
+        std::string    header_block;     // lines of the fields, names in lower case
+        std::size_t    line_start;       // the current line in header_block
+        std::vector<HeaderField>  header_fields;
         std::string    hostname;
         unsigned     hostport;
 
@@ -66,7 +107,7 @@ namespace ulxr
         std::string                         serverCookie;
         std::string                         clientCookie;
         std::vector<std::string>            userTempFields;
-        header_property                   headerprops;
+        bool                                keep_alive;
     };
 
 
@@ -112,19 +153,21 @@ namespace ulxr
     void HttpProtocol::init()
     {
         ULXR_TRACE("HttpProtocol::init()");
-        pimpl->headerprops.clear();
+        pimpl->line_start = 0;
         pimpl->useragent = ULXR_PACKAGE + std::string("/") + ULXR_VERSION;
         pimpl->userTempFields.clear();
         pimpl->bAcceptcookies = false;
+        pimpl->keep_alive = false;
     }
 
 
     void HttpProtocol::clearHttpInfo()
     {
         ULXR_TRACE("clearHttpInfo");
-        pimpl->header_firstline = "";
-        pimpl->header_buffer = "";
-        pimpl->headerprops.clear();
+        pimpl->header_firstline.clear();
+        pimpl->header_block.clear();
+        pimpl->line_start = 0;
+        pimpl->header_fields.clear();
         pimpl->cookies.clear();
     }
 
@@ -134,36 +177,66 @@ namespace ulxr
         ULXR_TRACE("resetConnection");
         Protocol::resetConnection();
         clearHttpInfo();
+        pimpl->keep_alive = false;
     }
 
 
     void HttpProtocol::closeConnection()
     {
         ULXR_TRACE("closeConnection");
+        pimpl->keep_alive = false;
         Protocol::closeConnection();
     }
 
 
+    bool HttpProtocol::isKeepAlive() const
+    {
+        return pimpl->keep_alive;
+    }
+
+
+    bool HttpProtocol::peerAllowsKeepAlive() const
+    {
+        const PImpl::HeaderField *field = pimpl->findField("connection");
+        if (field != 0)
+        {
+            std::string conn = pimpl->header_block.substr(field->value, field->value_len);
+            makeLower(conn);
+            if (conn.find("close") != std::string::npos)
+                return false;
+            if (conn.find("keep-alive") != std::string::npos)
+                return true;
+        }
+
+        // HTTP/1.1 is persistent by default, the version is in front of a
+        // response line and at the end of a request line
+        const std::string line = stripWS(getFirstHeaderLine());
+        const std::string version = "HTTP/1.1";
+        return line.compare(0, version.length() + 1, version + " ") == 0
+               || (line.length() > version.length()
+                   && line.compare(line.length() - version.length() - 1, version.length() + 1, " " + version) == 0);
+    }
+
+
     std::string HttpProtocol::getHttpProperty(const std::string &in_name) const
     {
         ULXR_TRACE("getHttpProperty " << in_name);
-        std::string name = in_name;
-        makeLower(name);
-        header_property::const_iterator it;
-
-        if ((it = pimpl->headerprops.find(name)) == pimpl->headerprops.end() )
+        const PImpl::HeaderField *field = pimpl->findField(in_name);
+        if (field == 0)
+        {
+            std::string name = in_name;
+            makeLower(name);
             throw ConnectionException(NotConformingError,
                                       "Http property field not available: "+name, 400);
+        }
 
-        return (*it).second;
+        return pimpl->header_block.substr(field->value, field->value_len);
     }
 
 
     bool HttpProtocol::hasHttpProperty(const std::string &in_name) const
     {
-        std::string name = in_name;
-        makeLower(name);
-        bool b = pimpl->headerprops.find(name) != pimpl->headerprops.end();
+        bool b = pimpl->findField(in_name) != 0;
         ULXR_TRACE("hasHttpProperty: " << in_name << " " << b);
         return b;
     }
@@ -173,41 +246,52 @@ namespace ulxr
     {
         ULXR_TRACE("parseHeaderLine");
 
+        std::string &block = pimpl->header_block;
+        const std::size_t start = pimpl->line_start;
         if (pimpl->header_firstline.empty())
         {
-            pimpl->header_firstline = pimpl->header_buffer;
+            pimpl->header_firstline.assign(block, start, std::string::npos);
+            block.resize(start);
             ULXR_DOUT_HTTP("firstline: <" << pimpl->header_firstline << ">");
         }
         else
         {
-            std::string prop_name, prop_val;
-            std::size_t pos = pimpl->header_buffer.find(':');
-            if (pos == std::string::npos)
+            // the field is kept where it is, only the borders are searched
+            std::size_t colon = block.find(':', start);
+            if (colon == std::string::npos)
+                colon = block.length();
+
+            PImpl::HeaderField field;
+            field.name = start;
+            field.name_len = colon - start;
+            field.value = std::min(colon + 1, block.length());
+            field.value_len = block.length() - field.value;
+
+            while (field.name_len != 0 && isspace(block[field.name]))
+                ++field.name, --field.name_len;
+            while (field.name_len != 0 && isspace(block[field.name + field.name_len - 1]))
+                --field.name_len;
+            while (field.value_len != 0 && isspace(block[field.value]))
+                ++field.value, --field.value_len;
+            while (field.value_len != 0 && isspace(block[field.value + field.value_len - 1]))
+                --field.value_len;
+
+            for (std::size_t i = field.name; i < field.name + field.name_len; ++i)
+                block[i] = tolower(block[i]);
+
+            pimpl->header_fields.push_back(field);
+
+            if (pimpl->bAcceptcookies)  // distinguish between cookie / set-cookie?
             {
-                prop_name = pimpl->header_buffer;
-                prop_val = "";
+                const std::string_view name(&block[field.name], field.name_len);
+                if (name == "set-cookie" || name == "cookie")
+                    setCookie(block.substr(field.value, field.value_len));
             }
-            else
-            {
-                prop_name = pimpl->header_buffer.substr(0, pos);
-                prop_val = pimpl->header_buffer.substr(pos+1);
-            }
-
-            makeLower(prop_name);
-            prop_val = stripWS(prop_val);
-            prop_name = stripWS(prop_name);
-            pimpl->headerprops.insert(std::make_pair(prop_name, prop_val));
 
-            if (pimpl->bAcceptcookies && (prop_name == "set-cookie"))  // distinguish between cookie / set-cookie?
-                setCookie(prop_val);
-
-            else if (pimpl->bAcceptcookies && (prop_name == "cookie"))
-                setCookie(prop_val);
-
-            ULXR_DOUT_HTTP("headerprop: <" << prop_name
-                           << "> + <" << prop_val << "> ");
+            ULXR_DOUT_HTTP("headerprop: <" << block.substr(field.name, field.name_len)
+                           << "> + <" << block.substr(field.value, field.value_len) << "> ");
         }
-        pimpl->header_buffer = "";
+        pimpl->line_start = block.length();
     }
 
     bool HttpProtocol::checkContinue()
@@ -231,12 +315,14 @@ namespace ulxr
     Protocol::State HttpProtocol::connectionMachine(char * &buffer, long &len)
     {
         /*
-          Each invocation of this state machine tries to parse one single
-          http header line of the buffer. If the content of the buffer is too small
-          (no linefeed found) the content is cached in an internal string
-          and used the next time.
-          buffer points to the beginning of the next line at return if
-          a linefeed has been found. In the message body nothing is done.
+          Each invocation of this state machine consumes as much of the
+          header as the buffer contains. The buffer is searched for the
+          next linefeed and everything up to it is appended to the current
+          line at once. Completed lines stay in a single string and are only
+          split into name and value, a line which is not complete yet is
+          continued the next time.
+          buffer points to the first byte after the header at return if
+          the end of the header has been found. In the message body nothing is done.
         */
         ULXR_TRACE("connectionMachine with " << len << " bytes");
         if (len == 0 || buffer == 0)
@@ -250,54 +336,46 @@ namespace ulxr
             case ConnStart:
                 setConnectionState(ConnHeaderLine);
                 clearHttpInfo();
-                break;
-
-            case ConnPendingCR:
-                if (*buffer == '\n') // CR+LF
-                {
-                    --len;
-                    ++buffer;
-                }
-
-                if (pimpl->header_buffer.empty())
-                    setConnectionState(ConnSwitchToBody);
-                else
-                    setConnectionState(ConnPendingHeaderLine);
+                pimpl->keep_alive = false;  // decided again when the header is complete
                 break;
 
             case ConnPendingHeaderLine:
-                if (pimpl->header_buffer.empty())
-                    setConnectionState(ConnSwitchToBody);
-
-                else if (*buffer != ' ')  // continuation line of current header field?
-                {
+                if (*buffer != ' ' && *buffer != '\t')  // continuation line of current header field?
                     parseHeaderLine();
-                    setConnectionState(ConnHeaderLine);
-                }
-                else
-                    setConnectionState(ConnHeaderLine);
+                setConnectionState(ConnHeaderLine);
                 break;
 
             case ConnHeaderLine:
-//            ULXR_TRACE("ConnHeaderLine:");
+            {
+                const char *eol = static_cast<const char*>(std::memchr(buffer, '\n', len));
+                const long part = eol != 0 ? eol - buffer : len;
+
+                std::string &block = pimpl->header_block;
+                if (block.length() + pimpl->header_firstline.length() + part > ULXR_MAX_HEADER_SIZE)
+                {
+                    setConnectionState(ConnError);
+                    throw ConnectionException(NotConformingError,
+                                              "Http header exceeds " + toString(ULXR_MAX_HEADER_SIZE) + " bytes", 431);
+                }
 
-                if (*buffer == '\r')
-                    setConnectionState(ConnPendingCR);
+                block.append(buffer, part);
+                buffer += part;
+                len -= part;
 
-                else if (*buffer == '\n')
+                if (eol != 0)
                 {
-                    if (pimpl->header_buffer.empty())
+                    ++buffer;
+                    --len;
+                    if (block.length() > pimpl->line_start && block[block.length()-1] == '\r')
+                        block.erase(block.length()-1);
+
+                    if (block.length() == pimpl->line_start)
                         setConnectionState(ConnSwitchToBody);
                     else
                         setConnectionState(ConnPendingHeaderLine);
                 }
-
-                else
-                    pimpl->header_buffer += *buffer;
-
-                ++buffer;
-                --len;
                 break;
+            }
 
             case ConnSwitchToBody:
                 machine_switchToBody(buffer, len);
@@ -341,6 +419,11 @@ namespace ulxr
                 if (getContentLength() >= 0)
                     setRemainingContentLength(getContentLength() - len);
             }
+
+            // without a length the end of the body is the end of the connection
+            pimpl->keep_alive = isPersistent()
+                                && getContentLength() >= 0
+                                && peerAllowsKeepAlive();
             setConnectionState(ConnBody);
         }
     }
@@ -356,18 +439,35 @@ namespace ulxr
     {
         ULXR_TRACE("determineContentLength");
 
-        header_property::iterator it;
-        if ((it = pimpl->headerprops.find("content-length")) != pimpl->headerprops.end() )
-        {
-            ULXR_TRACE(" content-length: " << it->second);
-            setContentLength(atoi(it->second.c_str()));
-            ULXR_TRACE(" length: " << getContentLength());
-        }
-        else
-        {
+        if (pimpl->findField("content-length") == 0)
             throw ConnectionException(NotConformingError,  "Content-Length of message not available", 411);
+
+        // only the digits of the value itself are accepted, repeated fields must agree
+        long length = -1;
+        for (std::size_t i = 0; i < pimpl->header_fields.size(); ++i)
+        {
+            const PImpl::HeaderField &field = pimpl->header_fields[i];
+            if (!pimpl->hasName(field, "content-length"))
+                continue;
+
+            ULXR_TRACE(" content-length: " << pimpl->header_block.substr(field.value, field.value_len));
+            const char *first = pimpl->header_block.data() + field.value;
+            const char *last = first + field.value_len;
+            long value = -1;
+            const std::from_chars_result res = std::from_chars(first, last, value);
+            if (   first == last || res.ec != std::errc() || res.ptr != last
+                || value < 0 || (length >= 0 && value != length))
+            {
+                pimpl->keep_alive = false;
+                throw ConnectionException(NotConformingError, "Invalid Content-Length of message", 400);
+            }
+
+            length = value;
         }
 
+        setContentLength(length);
+        ULXR_TRACE(" length: " << getContentLength());
+
         setRemainingContentLength(getContentLength());
         ULXR_TRACE(" content_length: " << getContentLength());
     }
@@ -380,6 +480,18 @@ namespace ulxr
                                      unsigned long len)
     {
         ULXR_TRACE("sendResponseHeader");
+        const std::string http_str = buildResponseHeader(code, phrase, type, len);
+        writeRaw(http_str.data(), http_str.length());
+    }
+
+
+    std::string
+    HttpProtocol::buildResponseHeader(int code,
+                                      const std::string &phrase,
+                                      const std::string &type,
+                                      unsigned long len)
+    {
+        ULXR_TRACE("buildResponseHeader");
         char stat[40];
         snprintf(stat, sizeof(stat), "%d", code );
 
@@ -402,8 +514,19 @@ namespace ulxr
             pos += 1;
         }
 
-        std::string http_str = std::string("HTTP/1.0 ") + stat + " " + ps + "\r\n";
-        http_str += "Connection: Close\r\n";
+        std::string http_str;
+        if (pimpl->keep_alive)
+        {
+            http_str = std::string("HTTP/1.1 ") + stat + " " + ps + "\r\n";
+            http_str += "Connection: Keep-Alive\r\n";
+            http_str += "Keep-Alive: timeout=" + toString(getKeepAliveTimeout())
+                        + ", max=" + toString(getMaxKeepAliveRequests() - getRequestCount()) + "\r\n";
+        }
+        else
+        {
+            http_str = std::string("HTTP/1.0 ") + stat + " " + ps + "\r\n";
+            http_str += "Connection: Close\r\n";
+        }
 
         if (len != 0 && type.length() != 0)
             http_str  += "Content-Type: " + type + "\r\n";
@@ -423,22 +546,35 @@ namespace ulxr
         http_str += "\r\n";    // empty line at end of header
 
         ULXR_DOUT_HTTP("resp: \n" << http_str.c_str());
-        writeRaw(http_str.data(), http_str.length());
+        return http_str;
     }
 
 
     void HttpProtocol::sendRequestHeader(const std::string &method,
-                                         const std::string &in_resource,
+                                         const std::string &resource,
                                          const std::string &type,
                                          unsigned long len)
     {
         ULXR_TRACE("sendRequestHeader");
+        const std::string http_str = buildRequestHeader(method, resource, type, len);
+        writeRaw(http_str.data(), http_str.length());
+    }
+
+
+    std::string HttpProtocol::buildRequestHeader(const std::string &method,
+                                                 const std::string &in_resource,
+                                                 const std::string &type,
+                                                 unsigned long len)
+    {
+        ULXR_TRACE("buildRequestHeader");
         char contlen[40];
         snprintf(contlen, sizeof(contlen), "%ld", len );
 
         char ports[40];
         snprintf(ports, sizeof(ports), "%d", pimpl->hostport);
         std::string resource = "http://" + pimpl->hostname + ":" + ports + in_resource;
+        // HTTP/1.0 keeps a server from answering with a chunked body,
+        // persistence is asked for with "Connection: Keep-Alive"
         std::string http_str = method + " " + resource + " HTTP/1.0\r\n";
         http_str += "Host: " + pimpl->hostname + "\r\n";
 
@@ -448,7 +584,10 @@ namespace ulxr
             http_str += "Proxy-Authorization: Basic "
                         + toBase64(str2Vec<unsigned char>(pimpl->proxy_user + ":" + pimpl->proxy_pass));
 
-        http_str += "Connection: Close\r\n";
+        if (isPersistent())
+            http_str += "Connection: Keep-Alive\r\n";
+        else
+            http_str += "Connection: Close\r\n";
         if (len != 0 && type.length() != 0)
             http_str += "Content-Type: " + type + "\r\n";
 
@@ -465,9 +604,8 @@ namespace ulxr
         http_str += "\r\n";    // empty line at end of header
 
         ULXR_DOUT_HTTP("req: \n" << http_str.c_str());
-
-        writeRaw(http_str.data(), http_str.length());
-    };
+        return http_str;
+    }
 
 
     std::string HttpProtocol::getDateStr()
@@ -514,8 +652,15 @@ namespace ulxr
                "</body>"
                "</html>";
 
-        sendResponseHeader(status, phrase, "text/html", msg.length());
-        writeRaw(msg.data(), msg.length());
+        // the rest of the request may still be unread
+        pimpl->keep_alive = false;
+        const std::string http_str = buildResponseHeader(status, phrase, "text/html", msg.length());
+        iovec pieces[2];
+        pieces[0].iov_base = const_cast<char*>(http_str.data());
+        pieces[0].iov_len = http_str.length();
+        pieces[1].iov_base = const_cast<char*>(msg.data());
+        pieces[1].iov_len = msg.length();
+        writeRaw(pieces, 2);
     }
 
 
@@ -523,11 +668,21 @@ namespace ulxr
     {
         ULXR_TRACE("sendRpcResponse");
 
-        std::string xml = resp.getXml(0)+"\n";
-        ULXR_DOUT_XML(xml);
+        ULXR_DOUT_XML(resp.getXml(0));
+
+        // the body is streamed after the header and never held completely,
+        // the header leaves together with the first part of it
+        // a connection is only reused after the whole request has been read
+        countRequest();
+        if (getRequestCount() >= getMaxKeepAliveRequests() || hasBytesToRead())
+            pimpl->keep_alive = false;
 
-        sendResponseHeader(200, "OK", "text/xml", xml.length());
-        writeBody(xml.data(), xml.length());
+        const XmlWriterOptions options = getXmlWriterOptions();
+        ConnectionSink sink(getConnection(), options);
+        sink.setPrefix(buildResponseHeader(200, "OK", "text/xml", resp.getXmlSize(options) + 1));
+        resp.serialize(sink);
+        sink.append('\n');
+        sink.flush();
     }
 
     void HttpProtocol::writeBody(const char *data, unsigned long len)
@@ -541,11 +696,14 @@ namespace ulxr
     {
         ULXR_TRACE("sendRpcCall");
 
-        std::string xml = call.getXml(0)+"\n";
-        ULXR_DOUT_XML(xml);
+        ULXR_DOUT_XML(call.getXml(0));
 
-        sendRequestHeader("POST", resource, "text/xml", xml.length());
-        writeBody(xml.data(), xml.length());
+        const XmlWriterOptions options = getXmlWriterOptions();
+        ConnectionSink sink(getConnection(), options);
+        sink.setPrefix(buildRequestHeader("POST", resource, "text/xml", call.getXmlSize(options) + 1));
+        call.serialize(sink);
+        sink.append('\n');
+        sink.flush();
         ULXR_TRACE("/sendRpcCall");
     };
 
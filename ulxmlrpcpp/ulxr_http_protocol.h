@@ -117,6 +117,15 @@ namespace ulxr {
           */
         virtual bool hasBytesToRead() const;
 
+        /** Tests if the connection stays open after the current message.
+          * Both sides must agree: persistence must be enabled, the peer must
+          * send HTTP/1.1 or "Connection: Keep-Alive" and a Content-Length.
+          * A server additionally closes after the maximum number of requests
+          * and after negative responses.
+          * @return true: the connection is kept alive
+          */
+        virtual bool isKeepAlive() const;
+
 //////////////////////////////////////////////////////////////////////////////////
 /// http stuff
 
@@ -333,12 +342,35 @@ namespace ulxr {
           */
         void init ();
 
+        /** Builds a http request header, see \c sendRequestHeader().
+          * The one time fields are used up.
+          * @return the header including the empty line at the end
+          */
+        std::string buildRequestHeader(const std::string &method,
+                                       const std::string &resource,
+                                       const std::string &type, unsigned long len);
+
+        /** Builds a http response header, see \c sendResponseHeader().
+          * The one time fields are used up.
+          * @return the header including the empty line at the end
+          */
+        std::string buildResponseHeader(int code,
+                                        const std::string &phrase,
+                                        const std::string &type,
+                                        unsigned long len);
+
         /** Statemachine switches to body.
           * @param  buffer       pointer to input data
           * @param len           valid length of buffer
           */
         void machine_switchToBody(char * &buffer, long &len);
 
+        /** Tests if the header of the peer allows to keep the connection.
+          * @return true: HTTP/1.1 without "Connection: close" or
+          *         "Connection: Keep-Alive"
+          */
+        bool peerAllowsKeepAlive() const;
+
     protected:
         HttpProtocol(const HttpProtocol&);
     private:
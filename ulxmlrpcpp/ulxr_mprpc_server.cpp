@@ -96,12 +96,32 @@ namespace ulxr {
     {}
 
 
+    void MultiProcessRpcServer::useArena(bool enable)
+    {
+        theDispatcher->useArena(enable);
+    }
+
+
+    bool MultiProcessRpcServer::isArenaUsed() const
+    {
+        return theDispatcher->isArenaUsed();
+    }
+
+
+    void MultiProcessRpcServer::useNativeParser(bool enable)
+    {
+        theDispatcher->useNativeParser(enable);
+    }
+
+
     void MultiProcessRpcServer::startChildLoop()
     {
         ULXR_TRACE("startChildLoop");
 
         Protocol* protocol = theDispatcher->getProtocol();
         Dispatcher waiter(protocol);
+        waiter.useArena(theDispatcher->isArenaUsed());
+        waiter.useNativeParser(theDispatcher->isNativeParserUsed());
 
         while(true)
         {
@@ -116,7 +136,8 @@ namespace ulxr {
                 preProcessResponse(resp);
 
                 protocol->sendRpcResponse(resp);
-                protocol->closeConnection();
+                if (!protocol->isKeepAlive())
+                    protocol->closeConnection();
             }
             catch (ConnectionException &ex)
             {
@@ -128,8 +149,11 @@ namespace ulxr {
                         protocol->sendRpcResponse(resp);
                     }
                     catch(...)
-                    {}
-                    protocol->closeConnection();
+                    {
+                        protocol->closeConnection();
+                    }
+                    if (!protocol->isKeepAlive())
+                        protocol->closeConnection();
                 }
             }
             catch(Exception& ex)
@@ -142,8 +166,11 @@ namespace ulxr {
                         protocol->sendRpcResponse(resp);
                     }
                     catch(...)
-                    {}
-                    protocol->closeConnection();
+                    {
+                        protocol->closeConnection();
+                    }
+                    if (!protocol->isKeepAlive())
+                        protocol->closeConnection();
                 }
             }
             catch(std::exception& ex)
@@ -156,8 +183,11 @@ namespace ulxr {
                         protocol->sendRpcResponse(resp);
                     }
                     catch(...)
-                    {}
-                    protocol->closeConnection();
+                    {
+                        protocol->closeConnection();
+                    }
+                    if (!protocol->isKeepAlive())
+                        protocol->closeConnection();
                 }
             }
             catch(...)
@@ -170,8 +200,11 @@ namespace ulxr {
                         protocol->sendRpcResponse(resp);
                     }
                     catch(...)
-                    {}
-                    protocol->closeConnection();
+                    {
+                        protocol->closeConnection();
+                    }
+                    if (!protocol->isKeepAlive())
+                        protocol->closeConnection();
                 }
             }
 
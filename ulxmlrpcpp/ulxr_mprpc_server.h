@@ -102,6 +102,24 @@ namespace ulxr {
           */
         virtual void preProcessResponse(MethodResponse &resp);
 
+        /** Selects if incoming calls are parsed into a ValueArena.
+          * The parameters of a call are then freed in one go when the
+          * last copy of the MethodCall is destroyed.
+          * @param  enable  true: use an arena for each call
+          */
+        void useArena(bool enable);
+
+        /** Tests if incoming calls are parsed into a ValueArena.
+          * @return true in arena mode
+          */
+        bool isArenaUsed() const;
+
+        /** Selects if incoming calls are read by the native \c PullParser.
+          * Expat is used by default.
+          * @param  enable  true: use the native parser
+          */
+        void useNativeParser(bool enable);
+
 
 
         /** Adds a user defined (static) method to the dispatcher.
@@ -34,10 +34,16 @@
 
 
 #include <ulxmlrpcpp/ulxmlrpcpp.h>
+
+#include <algorithm>
+#include <cstring>
+#include <optional>
+
 #include <ulxmlrpcpp/ulxr_connection.h>
 #include <ulxmlrpcpp/ulxr_protocol.h>
 #include <ulxmlrpcpp/ulxr_response.h>
 #include <ulxmlrpcpp/ulxr_call.h>
+#include <ulxmlrpcpp/ulxr_xmlsink.h>
 
 
 namespace ulxr {
@@ -66,6 +72,17 @@ namespace ulxr {
         long            remain_content_length;
 
         std::vector<AuthData>  authdata;
+
+        bool            persistent;
+        unsigned        keepalive_timeout;
+        unsigned        keepalive_max;
+        unsigned        requests;
+
+        std::vector<char>  input;
+        std::size_t        input_pos;
+        std::size_t        input_end;
+
+        std::optional<XmlWriterOptions>  writer_options;
     };
 
 
@@ -82,6 +99,12 @@ namespace ulxr {
         pimpl->connection = conn;
         pimpl->delete_connection = false;
         ULXR_TRACE("Protocol");
+        pimpl->persistent = false;
+        pimpl->keepalive_timeout = 15;
+        pimpl->keepalive_max = 100;
+        pimpl->requests = 0;
+        pimpl->input_pos = 0;
+        pimpl->input_end = 0;
         init();
     }
 
@@ -111,6 +134,13 @@ namespace ulxr {
     }
 
 
+    void Protocol::writeRaw(const iovec *iov, int count)
+    {
+        ULXR_TRACE("writeRaw iovec");
+        getConnection()->write(iov, count);
+    }
+
+
     long Protocol::readRaw(char *buff, long len)
     {
         ULXR_TRACE("readRaw, want: " << len);
@@ -121,7 +151,25 @@ namespace ulxr {
                 len = pimpl->remain_content_length;
         }
 
-        long myRead = getConnection()->read(buff, len);
+        if (len <= 0)
+            return 0;
+
+        long myRead;
+        if (pimpl->input_pos < pimpl->input_end)
+            myRead = takeInput(buff, len);
+
+        // a large read of the body cannot pass the end of the message
+        else if (pimpl->connstate == ConnBody && len >= ULXR_RECV_BUFFER_SIZE)
+            myRead = getConnection()->read(buff, len);
+
+        else
+        {
+            if (pimpl->input.empty())
+                pimpl->input.resize(ULXR_RECV_BUFFER_SIZE);
+            pimpl->input_pos = 0;
+            pimpl->input_end = getConnection()->read(&pimpl->input[0], pimpl->input.size());
+            myRead = takeInput(buff, len);
+        }
 
         if (pimpl->remain_content_length >= 0)
             pimpl->remain_content_length -= myRead;
@@ -130,10 +178,48 @@ namespace ulxr {
     }
 
 
+    long Protocol::takeInput(char *buff, long len)
+    {
+        const char *data = &pimpl->input[pimpl->input_pos];
+        std::size_t avail = std::min<std::size_t>(len, pimpl->input_end - pimpl->input_pos);
+
+        // the length of the body is only known after the header
+        if (pimpl->connstate != ConnBody)
+        {
+            const char *eol = static_cast<const char*>(std::memchr(data, '\n', avail));
+            if (eol != 0)
+                avail = eol - data + 1;
+        }
+
+        std::memcpy(buff, data, avail);
+        pimpl->input_pos += avail;
+        ULXR_TRACE("takeInput " << avail);
+        return avail;
+    }
+
+
+    void Protocol::clearInput()
+    {
+        pimpl->input_pos = 0;
+        pimpl->input_end = 0;
+    }
+
+
+    bool Protocol::waitForInput(unsigned timeout_sec)
+    {
+        ULXR_TRACE("waitForInput " << timeout_sec);
+        if (pimpl->input_pos < pimpl->input_end)
+            return true;
+        return getConnection()->waitForInput(timeout_sec);
+    }
+
+
     void Protocol::open()
     {
         ULXR_TRACE("open");
         getConnection()->open();
+        pimpl->requests = 0;
+        clearInput();
         resetConnection();
     }
 
@@ -151,6 +237,8 @@ namespace ulxr {
     {
         ULXR_TRACE("accept");
         bool res = getConnection()->accept(_timeout);
+        pimpl->requests = 0;
+        clearInput();
         resetConnection();
         return res;
     }
@@ -159,6 +247,7 @@ namespace ulxr {
     void Protocol::closeConnection()
     {
         ULXR_TRACE("closeConnection");
+        clearInput();
         if (getConnection())
             getConnection()->close();
 //  resetConnection();
@@ -236,8 +325,10 @@ namespace ulxr {
     void Protocol::sendRpcResponse(const MethodResponse &resp)
     {
         ULXR_TRACE("sendRpcResponse");
-        std::string xml = resp.getXml(0)+"\n";
-        getConnection()->write(xml.c_str(), xml.length());
+        ConnectionSink sink(getConnection(), getXmlWriterOptions());
+        resp.serialize(sink);
+        sink.append('\n');
+        sink.flush();
     }
 
 
@@ -245,8 +336,75 @@ namespace ulxr {
                                const std::string &/*resource*/)
     {
         ULXR_TRACE("sendRpcCall");
-        std::string xml = call.getXml(0)+"\n";
-        getConnection()->write(xml.c_str(), xml.length());
+        ConnectionSink sink(getConnection(), getXmlWriterOptions());
+        call.serialize(sink);
+        sink.append('\n');
+        sink.flush();
+    }
+
+
+    void Protocol::setXmlWriterOptions(const XmlWriterOptions &options)
+    {
+        pimpl->writer_options = options;
+    }
+
+
+    XmlWriterOptions Protocol::getXmlWriterOptions() const
+    {
+        if (pimpl->writer_options)
+            return *pimpl->writer_options;
+        return XmlWriterOptions();
+    }
+
+
+    void Protocol::setPersistent(bool persistent)
+    {
+        ULXR_TRACE("setPersistent " << persistent);
+        pimpl->persistent = persistent;
+    }
+
+
+    bool Protocol::isPersistent() const
+    {
+        return pimpl->persistent;
+    }
+
+
+    void Protocol::setKeepAliveLimits(unsigned idle_timeout, unsigned max_requests)
+    {
+        ULXR_TRACE("setKeepAliveLimits " << idle_timeout << " " << max_requests);
+        pimpl->keepalive_timeout = idle_timeout;
+        pimpl->keepalive_max = max_requests;
+    }
+
+
+    unsigned Protocol::getKeepAliveTimeout() const
+    {
+        return pimpl->keepalive_timeout;
+    }
+
+
+    unsigned Protocol::getMaxKeepAliveRequests() const
+    {
+        return pimpl->keepalive_max;
+    }
+
+
+    bool Protocol::isKeepAlive() const
+    {
+        return false;
+    }
+
+
+    unsigned Protocol::getRequestCount() const
+    {
+        return pimpl->requests;
+    }
+
+
+    void Protocol::countRequest()
+    {
+        ++pimpl->requests;
     }
 
 
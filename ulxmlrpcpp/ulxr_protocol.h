@@ -33,6 +33,7 @@
 #include <ulxmlrpcpp/ulxmlrpcpp.h>
 
 #include <vector>
+#include <sys/uio.h>
 
 
 namespace ulxr {
@@ -45,6 +46,7 @@ namespace ulxr {
     class MethodCall;
     class MethodResponse;
     class Connection;
+    class XmlWriterOptions;
 
     /** Base class for the protocol of the rpc transportation.
       * @ingroup grp_ulxr_protocol
@@ -68,13 +70,29 @@ namespace ulxr {
           */
         void writeRaw(char const *buff, long len);
 
+        /** Writes several pieces of data to the connection in one go.
+          * @param  iov    the pieces in the order to write
+          * @param  count  number of pieces
+          */
+        void writeRaw(const iovec *iov, int count);
+
         /** Reads data from the connection.
+          * The connection is read in large blocks. Bytes beyond the end of
+          * the current message are kept for the next one, so the header is
+          * handed out line by line and the body up to its length.
           * @param  buff pointer to data buffer
           * @param  len  maimum number of bytes to read into buffer
           * @return number of actually read bytes
           */
         long readRaw(char *buff, long len);
 
+        /** Waits until data arrives or the peer closes the connection.
+          * Data which has already been read with the previous message counts.
+          * @param  timeout_sec  maximum time to wait, 0 only tests the current state
+          * @return true: the next readRaw() does not block
+          */
+        bool waitForInput(unsigned timeout_sec);
+
         /** Opens the connection in rpc client mode.
           */
         virtual void open();
@@ -123,7 +141,53 @@ namespace ulxr {
           */
         virtual void sendRpcResponse(const MethodResponse &resp);
 
+        /** Sets the options for the xml of the calls and responses which are sent.
+          * Without options the process wide settings at the time of sending are used.
+          * @param   options     settings for the generated xml
+          */
+        void setXmlWriterOptions(const XmlWriterOptions &options);
+
+        /** Returns the options for the xml of the next call or response.
+          * @return  settings for the generated xml
+          */
+        XmlWriterOptions getXmlWriterOptions() const;
+
 
+        /** Enables persistent connections.
+          * A persistent connection stays open after a call and its response
+          * if the peer agrees, so the next call saves the connection setup.
+          * @param   persistent   true: keep connections alive
+          */
+        void setPersistent(bool persistent);
+
+        /** Tests if persistent connections are enabled.
+          * @return true: connections are kept alive
+          */
+        bool isPersistent() const;
+
+        /** Sets the limits for persistent connections on the server side.
+          * @param   idle_timeout   time [sec] a connection may stay idle before
+          *                         the server closes it
+          * @param   max_requests   number of requests after which the server
+          *                         closes a connection
+          */
+        void setKeepAliveLimits(unsigned idle_timeout, unsigned max_requests);
+
+        /** Returns the time a persistent connection may stay idle.
+          * @return time in seconds
+          */
+        unsigned getKeepAliveTimeout() const;
+
+        /** Returns the number of requests served over one persistent connection.
+          * @return maximum number of requests
+          */
+        unsigned getMaxKeepAliveRequests() const;
+
+        /** Tests if the connection stays open after the current message.
+          * This is the agreement of both peers in the last exchanged header.
+          * @return true: the connection is kept alive
+          */
+        virtual bool isKeepAlive() const;
 
         /** Tests if the response was successful regarding the transportation.
           * @param   phrase  return value describing the problem.
@@ -237,6 +301,15 @@ namespace ulxr {
           */
         void setContentLength(long len);
 
+        /** Returns the number of requests received over the current connection.
+          * @return number of requests
+          */
+        unsigned getRequestCount() const;
+
+        /** Counts a request which was received over the current connection.
+          */
+        void countRequest();
+
         /** Extracts username and password from current message.
           * @param  user   reference to return username
           * @param  pass   reference to return password
@@ -259,6 +332,17 @@ namespace ulxr {
           */
         void init();
 
+        /** Hands out data from the input buffer.
+          * @param  buff pointer to data buffer
+          * @param  len  maimum number of bytes to read into buffer
+          * @return number of bytes taken from the input buffer
+          */
+        long takeInput(char *buff, long len);
+
+        /** Discards the input buffer of the previous connection.
+          */
+        void clearInput();
+
     private:
 
         struct AuthData;
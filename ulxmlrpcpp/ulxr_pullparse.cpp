@@ -0,0 +1,958 @@
+/***************************************************************************
+            ulxr_pullparse.cpp  -  native xml parser for xml-rpc
+                             -------------------
+    begin                : Sat Oct 17 2026
+    copyright            : (C) 2026 by the ulxmlrpcpp developers
+
+    $Id$
+
+ ***************************************************************************/
+
+/**************************************************************************
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ *
+ ***************************************************************************/
+
+//#define ULXR_DEBUG_OUTPUT
+
+
+#include <ulxmlrpcpp/ulxmlrpcpp.h>
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <strings.h>
+
+#include <ulxmlrpcpp/ulxr_pullparse.h>
+
+
+namespace ulxr {
+
+
+    namespace {
+
+        inline bool isSpace(char c)
+        {
+            return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+        }
+
+
+        // the characters which may follow a name in a tag
+        inline bool endsName(char c)
+        {
+            return isSpace(c) || c == '/' || c == '>' || c == '=';
+        }
+
+
+        inline bool isNameStart(char c)
+        {
+            return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')
+                || c == '_' || c == ':' || (c & 0x80) != 0;
+        }
+
+
+        inline bool isNameChar(char c)
+        {
+            return isNameStart(c) || (c >= '0' && c <= '9') || c == '-' || c == '.';
+        }
+
+
+        // Searches a terminator like "-->" which ends with '>'.
+        // Returns the position after the terminator or 0.
+        const char *findClose(const char *from, const char *end, const char *close, std::size_t len)
+        {
+            const char *p = from + len - 1;
+            while (p < end)
+            {
+                p = static_cast<const char*>(std::memchr(p, '>', end - p));
+                if (p == 0)
+                    return 0;
+
+                if (std::memcmp(p - (len - 1), close, len) == 0)
+                    return p + 1;
+
+                ++p;
+            }
+            return 0;
+        }
+
+
+        bool isXmlChar(unsigned long c)
+        {
+            return c == 0x9 || c == 0xA || c == 0xD
+                || (c >= 0x20    && c <= 0xD7FF)
+                || (c >= 0xE000  && c <= 0xFFFD)
+                || (c >= 0x10000 && c <= 0x10FFFF);
+        }
+
+
+        // Checks that the text consists of xml characters in UTF-8.
+        // Returns the end of the valid part.
+        const char *checkUtf8(const char *p, const char *end)
+        {
+            const std::uint64_t high = 0x8080808080808080ULL;
+            const std::uint64_t blank = 0x2020202020202020ULL;
+            while (p != end)
+            {
+                if (end - p >= 8)   // eight plain ascii characters at once
+                {
+                    std::uint64_t w;
+                    std::memcpy(&w, p, 8);
+                    if (((w | ((w - blank) & ~w)) & high) == 0)
+                    {
+                        p += 8;
+                        continue;
+                    }
+                }
+
+                const unsigned char c = *p;
+                if (c < 0x80)
+                {
+                    if (c < 0x20 && c != '\t' && c != '\n' && c != '\r')
+                        return p;
+
+                    ++p;
+                    continue;
+                }
+
+                std::size_t len;
+                unsigned long u;
+                if (c >= 0xC2 && c <= 0xDF)
+                {
+                    len = 2;
+                    u = c & 0x1F;
+                }
+                else if (c >= 0xE0 && c <= 0xEF)
+                {
+                    len = 3;
+                    u = c & 0x0F;
+                }
+                else if (c >= 0xF0 && c <= 0xF4)
+                {
+                    len = 4;
+                    u = c & 0x07;
+                }
+                else
+                    return p;
+
+                if (std::size_t(end - p) < len)
+                    return p;
+
+                for (std::size_t i = 1; i < len; ++i)
+                {
+                    const unsigned char cc = p[i];
+                    if ((cc & 0xC0) != 0x80)
+                        return p;
+
+                    u = (u << 6) | (cc & 0x3F);
+                }
+
+                if ((len == 3 && u < 0x800) || (len == 4 && u < 0x10000) || !isXmlChar(u))
+                    return p;
+
+                p += len;
+            }
+            return p;
+        }
+
+
+        std::size_t encodeUtf8(unsigned long c, char *buff)
+        {
+            if (c < 0x80)
+            {
+                buff[0] = static_cast<char>(c);
+                return 1;
+            }
+
+            if (c < 0x800)
+            {
+                buff[0] = static_cast<char>(0xC0 | (c >> 6));
+                buff[1] = static_cast<char>(0x80 | (c & 0x3F));
+                return 2;
+            }
+
+            if (c < 0x10000)
+            {
+                buff[0] = static_cast<char>(0xE0 | (c >> 12));
+                buff[1] = static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+                buff[2] = static_cast<char>(0x80 | (c & 0x3F));
+                return 3;
+            }
+
+            buff[0] = static_cast<char>(0xF0 | (c >> 18));
+            buff[1] = static_cast<char>(0x80 | ((c >> 12) & 0x3F));
+            buff[2] = static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+            buff[3] = static_cast<char>(0x80 | (c & 0x3F));
+            return 4;
+        }
+
+
+        const std::size_t maxReference = 32;   // "&#x0000...;"
+
+    }  // namespace
+
+
+    PullParser::PullParser()
+    {
+        names.reserve(256);
+        name_starts.reserve(16);
+        attrs.reserve(8);
+        reset();
+    }
+
+
+    void PullParser::reset()
+    {
+        pos = end = data = data_end = 0;
+        carry.clear();
+        in_carry = false;
+        names.clear();
+        name_starts.clear();
+        name = "";
+        text = 0;
+        text_len = 0;
+        after_cr = false;
+        final = false;
+        at_start = true;
+        root_seen = false;
+        pending_pop = false;
+        pending_end = false;
+        error = eNoError;
+        line = 1;
+    }
+
+
+    void PullParser::feed(const char *buff, std::size_t len, bool isFinal)
+    {
+        data = buff;
+        data_end = buff + len;
+        final = isFinal;
+        if (!in_carry)
+        {
+            pos = data;
+            end = data_end;
+        }
+    }
+
+
+    PullParser::Event PullParser::next()
+    {
+        if (error != eNoError)
+            return eError;
+
+        if (pending_pop)
+        {
+            pending_pop = false;
+            names.resize(name_starts.back());
+            name_starts.pop_back();
+        }
+
+        if (pending_end)   // an empty element like <value/>
+        {
+            pending_end = false;
+            pending_pop = true;
+            return eEndTag;
+        }
+
+        for (;;)
+        {
+            if (pos == end)
+            {
+                if (in_carry)
+                {
+                    carry.clear();
+                    in_carry = false;
+                    pos = data;
+                    end = data_end;
+                    continue;
+                }
+
+                if (!final)
+                    return eNeedInput;
+
+                if (!root_seen)
+                    return fail(eNoElements);
+
+                if (!name_starts.empty())
+                    return fail(eUnclosedToken);
+
+                return eEnd;
+            }
+
+            if (after_cr)   // CRLF cut between two texts
+            {
+                after_cr = false;
+                if (*pos == '\n')
+                {
+                    consume(pos + 1);
+                    continue;
+                }
+            }
+
+            Event event = eNeedInput;
+            Step step;
+            if (*pos == '<')
+                step = readMarkup(event);
+
+            else if (*pos == '&')
+                step = readReference(event);
+
+            else
+                step = readText(event);
+
+            if (step == stepEvent)
+                return event;
+
+            if (step == stepMore && !moreInput(*pos == '&' ? ';' : '>'))
+                return final ? fail(eUnclosedToken) : eNeedInput;
+        }
+    }
+
+
+    const char *PullParser::getName() const
+    {
+        return name;
+    }
+
+
+    std::string_view PullParser::getText() const
+    {
+        return std::string_view(text, text_len);
+    }
+
+
+    PullParser::Error PullParser::getError() const
+    {
+        return error;
+    }
+
+
+    const char *PullParser::getErrorString(unsigned code)
+    {
+        switch (code)
+        {
+        case eNoError:             return "no error";
+        case eSyntaxError:         return "syntax error";
+        case eInvalidToken:        return "not well-formed (invalid token)";
+        case eNoElements:          return "no element found";
+        case eUnclosedToken:       return "unclosed token";
+        case eTagMismatch:         return "mismatched tag";
+        case eJunkAfterDocElement: return "junk after document element";
+        case eUndefinedEntity:     return "undefined entity";
+        case eBadCharRef:          return "reference to invalid character number";
+        case eUnsupportedMarkup:   return "document type declarations are not supported";
+        case eUnknownEncoding:     return "unknown encoding";
+        case eNestingTooDeep:      return "elements nested too deeply";
+        }
+
+        return "unknown error";
+    }
+
+
+    int PullParser::getLineNumber() const
+    {
+        return line;
+    }
+
+
+    PullParser::Event PullParser::fail(Error err)
+    {
+        ULXR_TRACE("PullParser::fail " << getErrorString(err));
+        error = err;
+        return eError;
+    }
+
+
+    void PullParser::consume(const char *to)
+    {
+        line += std::count(pos, to, '\n');
+        pos = to;
+    }
+
+
+    bool PullParser::moreInput(char stop)
+    {
+        // the token starting at pos is completed in carry
+        if (!in_carry)
+        {
+            carry.assign(pos, end);
+            in_carry = true;
+            data = data_end;
+        }
+        else if (pos != carry.data())
+            carry.erase(0, pos - carry.data());
+
+        bool appended = false;
+        if (data != data_end)
+        {
+            const char *found = static_cast<const char*>(std::memchr(data, stop, data_end - data));
+            const char *upto = found != 0 ? found + 1 : data_end;
+            carry.append(data, upto);
+            data = upto;
+            appended = true;
+        }
+
+        pos = carry.data();
+        end = pos + carry.length();
+        return appended;
+    }
+
+
+    PullParser::Step PullParser::readText(Event &event)
+    {
+        const char *stop = static_cast<const char*>(std::memchr(pos, '<', end - pos));
+        if (stop == 0)
+            stop = end;
+
+        const char *amp = static_cast<const char*>(std::memchr(pos, '&', stop - pos));
+        if (amp == 0)
+            amp = stop;
+
+        if (name_starts.empty())   // outside of the root element
+        {
+            if (at_start && std::memcmp(pos, "\xEF\xBB\xBF", std::min<std::size_t>(amp - pos, 3)) == 0)
+            {
+                if (amp - pos >= 3)
+                {
+                    pos += 3;   // byte order mark
+                    return stepSkip;
+                }
+
+                if (amp == end)
+                    return stepMore;
+            }
+
+            for (const char *p = pos; p != amp; ++p)
+                if (!isSpace(*p))
+                {
+                    event = fail(root_seen ? eJunkAfterDocElement : eSyntaxError);
+                    return stepEvent;
+                }
+
+            at_start = false;
+            consume(amp);
+            return stepSkip;
+        }
+
+        const char *valid = checkUtf8(pos, amp);
+        if (valid != amp)
+        {
+            // a character may be cut off at the end of the piece
+            if (amp != end || end - valid >= 4 || final)
+            {
+                event = fail(eInvalidToken);
+                return stepEvent;
+            }
+
+            if (valid == pos)
+                return stepMore;
+        }
+
+        // "]]>" must not occur in text, "]" at the end of the piece waits for the next one
+        const char *last = valid;
+        if (valid == end && !final)
+            while (last != pos && valid - last < 2 && last[-1] == ']')
+                --last;
+
+        if (last == pos)
+            return stepMore;
+
+        for (const char *gt = pos + 2;
+             gt < last && (gt = static_cast<const char*>(std::memchr(gt, '>', last - gt))) != 0; ++gt)
+            if (gt[-1] == ']' && gt[-2] == ']')
+            {
+                event = fail(eSyntaxError);
+                return stepEvent;
+            }
+
+        setText(pos, last);
+        after_cr = last[-1] == '\r';
+        consume(last);
+        event = eText;
+        return stepEvent;
+    }
+
+
+    void PullParser::setText(const char *from, const char *to)
+    {
+        text = from;
+        text_len = to - from;
+        const char *cr = static_cast<const char*>(std::memchr(from, '\r', to - from));
+        if (cr == 0)
+            return;
+
+        // CRLF and a single CR become LF
+        lines.assign(from, cr);
+        for (const char *p = cr; p != to; ++p)
+        {
+            if (*p != '\r')
+                lines += *p;
+
+            else
+            {
+                lines += '\n';
+                if (p + 1 != to && p[1] == '\n')
+                    ++p;
+            }
+        }
+
+        text = lines.data();
+        text_len = lines.length();
+    }
+
+
+    PullParser::Step PullParser::readReference(Event &event)
+    {
+        const std::size_t avail = end - pos;
+        const char *semi = static_cast<const char*>(std::memchr(pos, ';', std::min(avail, maxReference)));
+        if (semi == 0)
+        {
+            if (avail < maxReference)
+                return stepMore;
+
+            event = fail(eSyntaxError);
+            return stepEvent;
+        }
+
+        if (name_starts.empty())
+        {
+            event = fail(root_seen ? eJunkAfterDocElement : eSyntaxError);
+            return stepEvent;
+        }
+
+        const Error err = resolveReference(std::string_view(pos + 1, semi - pos - 1));
+        if (err != eNoError)
+        {
+            event = fail(err);
+            return stepEvent;
+        }
+
+        consume(semi + 1);
+        event = eText;
+        return stepEvent;
+    }
+
+
+    PullParser::Error PullParser::resolveReference(std::string_view entity)
+    {
+        text_len = 1;
+        if (entity == "lt")
+            text = "<";
+
+        else if (entity == "gt")
+            text = ">";
+
+        else if (entity == "amp")
+            text = "&";
+
+        else if (entity == "quot")
+            text = "\"";
+
+        else if (entity == "apos")
+            text = "'";
+
+        else if (entity.length() > 1 && entity[0] == '#')
+        {
+            const bool hex = entity[1] == 'x';
+            const char *first = entity.data() + (hex ? 2 : 1);
+            const char *last = entity.data() + entity.length();
+            unsigned long c = 0;
+            const std::from_chars_result res = std::from_chars(first, last, c, hex ? 16 : 10);
+            if (first == last || res.ptr != last || res.ec != std::errc() || !isXmlChar(c))
+                return eBadCharRef;
+
+            text_len = encodeUtf8(c, ref);
+            text = ref;
+        }
+
+        else
+            return eUndefinedEntity;
+
+        return eNoError;
+    }
+
+
+    PullParser::Step PullParser::readMarkup(Event &event)
+    {
+        const std::size_t avail = end - pos;
+        if (avail < 2)
+            return stepMore;
+
+        if (pos[1] == '/')
+            return readEndTag(event);
+
+        if (pos[1] == '?')
+        {
+            const char *close = findClose(pos + 2, end, "?>", 2);
+            if (close == 0)
+                return stepMore;
+
+            if (checkUtf8(pos, close) != close)
+            {
+                event = fail(eInvalidToken);
+                return stepEvent;
+            }
+
+            if (!readDeclaration(close))
+            {
+                event = fail(error == eNoError ? eSyntaxError : error);
+                return stepEvent;
+            }
+
+            at_start = false;
+            consume(close);
+            return stepSkip;
+        }
+
+        if (pos[1] != '!')
+            return readStartTag(event);
+
+        if (std::memcmp(pos, "<!--", std::min<std::size_t>(avail, 4)) == 0)
+        {
+            if (avail < 4)
+                return stepMore;
+
+            const char *close = findClose(pos + 4, end, "-->", 3);
+            if (close == 0)
+                return stepMore;
+
+            if (checkUtf8(pos, close) != close)
+            {
+                event = fail(eInvalidToken);
+                return stepEvent;
+            }
+
+            // "--" must not occur inside a comment
+            for (const char *dash = pos + 4;
+                 (dash = static_cast<const char*>(std::memchr(dash, '-', close - 3 - dash))) != 0; ++dash)
+                if (dash[1] == '-')
+                {
+                    event = fail(eSyntaxError);
+                    return stepEvent;
+                }
+
+            at_start = false;
+            consume(close);
+            return stepSkip;
+        }
+
+        if (std::memcmp(pos, "<![CDATA[", std::min<std::size_t>(avail, 9)) == 0)
+        {
+            if (avail < 9)
+                return stepMore;
+
+            const char *close = findClose(pos + 9, end, "]]>", 3);
+            if (close == 0)
+                return stepMore;
+
+            if (name_starts.empty())
+            {
+                event = fail(eSyntaxError);
+                return stepEvent;
+            }
+
+            if (checkUtf8(pos + 9, close - 3) != close - 3)
+            {
+                event = fail(eInvalidToken);
+                return stepEvent;
+            }
+
+            setText(pos + 9, close - 3);
+
+            consume(close);
+            event = eText;
+            return stepEvent;
+        }
+
+        event = fail(eUnsupportedMarkup);
+        return stepEvent;
+    }
+
+
+    PullParser::Step PullParser::readStartTag(Event &event)
+    {
+        const char *p = pos + 1;
+        while (p != end && isNameChar(*p))
+            ++p;
+
+        if (p == end)
+            return stepMore;
+
+        const char *name_end = p;
+        bool empty = false;
+        attrs.clear();
+        if (name_end == pos + 1 || !isNameStart(pos[1]) || !endsName(*p))
+        {
+            event = fail(eSyntaxError);
+            return stepEvent;
+        }
+
+        for (;;)   // attributes are checked and skipped
+        {
+            const char *space = p;
+            while (p != end && isSpace(*p))
+                ++p;
+
+            if (p == end)
+                return stepMore;
+
+            if (*p == '>')
+            {
+                ++p;
+                break;
+            }
+
+            if (*p == '/')
+            {
+                if (p + 1 == end)
+                    return stepMore;
+
+                if (p[1] != '>')
+                {
+                    event = fail(eSyntaxError);
+                    return stepEvent;
+                }
+
+                p += 2;
+                empty = true;
+                break;
+            }
+
+            const char *attr = p;
+            while (p != end && isNameChar(*p))
+                ++p;
+
+            const char *attr_end = p;
+            while (p != end && isSpace(*p))
+                ++p;
+
+            if (p == end)
+                return stepMore;
+
+            if (space == attr || attr == attr_end || !isNameStart(*attr) || *p != '=')
+            {
+                event = fail(eSyntaxError);
+                return stepEvent;
+            }
+
+            const std::string_view attr_name(attr, attr_end - attr);
+            if (std::find(attrs.begin(), attrs.end(), attr_name) != attrs.end())
+            {
+                event = fail(eSyntaxError);
+                return stepEvent;
+            }
+
+            attrs.push_back(attr_name);
+
+            ++p;
+            while (p != end && isSpace(*p))
+                ++p;
+
+            if (p == end)
+                return stepMore;
+
+            if (*p != '"' && *p != '\'')
+            {
+                event = fail(eSyntaxError);
+                return stepEvent;
+            }
+
+            const char *quote = static_cast<const char*>(std::memchr(p + 1, *p, end - p - 1));
+            if (quote == 0)
+                return stepMore;
+
+            if (std::memchr(p + 1, '<', quote - p - 1) != 0)
+            {
+                event = fail(eSyntaxError);
+                return stepEvent;
+            }
+
+            for (const char *amp = p + 1;
+                 (amp = static_cast<const char*>(std::memchr(amp, '&', quote - amp))) != 0; )
+            {
+                const char *semi = static_cast<const char*>(std::memchr(amp, ';', quote - amp));
+                const Error err = semi == 0 ? eSyntaxError
+                                            : resolveReference(std::string_view(amp + 1, semi - amp - 1));
+                if (err != eNoError)
+                {
+                    event = fail(err);
+                    return stepEvent;
+                }
+
+                amp = semi + 1;
+            }
+
+            p = quote + 1;
+        }
+
+        if (checkUtf8(pos, p) != p)
+        {
+            event = fail(eInvalidToken);
+            return stepEvent;
+        }
+
+        if (root_seen && name_starts.empty())
+        {
+            event = fail(eJunkAfterDocElement);
+            return stepEvent;
+        }
+
+        if (name_starts.size() >= ULXR_MAX_XML_DEPTH)
+        {
+            event = fail(eNestingTooDeep);
+            return stepEvent;
+        }
+
+        name_starts.push_back(names.length());
+        names.append(pos + 1, name_end);
+        names += '\0';
+        name = names.data() + name_starts.back();
+
+        root_seen = true;
+        at_start = false;
+        pending_end = empty;
+        consume(p);
+        event = eStartTag;
+        return stepEvent;
+    }
+
+
+    PullParser::Step PullParser::readEndTag(Event &event)
+    {
+        const char *gt = static_cast<const char*>(std::memchr(pos + 2, '>', end - pos - 2));
+        if (gt == 0)
+            return stepMore;
+
+        const char *name_end = gt;
+        while (name_end != pos + 2 && isSpace(name_end[-1]))
+            --name_end;
+
+        if (name_starts.empty())
+        {
+            event = fail(root_seen ? eJunkAfterDocElement : eSyntaxError);
+            return stepEvent;
+        }
+
+        const std::size_t start = name_starts.back();
+        const std::size_t len = names.length() - start - 1;
+        if (std::size_t(name_end - (pos + 2)) != len
+            || std::memcmp(pos + 2, names.data() + start, len) != 0)
+        {
+            event = fail(eTagMismatch);
+            return stepEvent;
+        }
+
+        name = names.data() + start;
+        pending_pop = true;
+        consume(gt + 1);
+        event = eEndTag;
+        return stepEvent;
+    }
+
+
+    bool PullParser::readDeclaration(const char *close)
+    {
+        const char *target = pos + 2;
+        const char *target_end = target;
+        while (target_end != close - 2 && isNameChar(*target_end))
+            ++target_end;
+
+        if (target_end == target || !isNameStart(*target)
+            || (target_end != close - 2 && !isSpace(*target_end)))
+            return false;
+
+        const std::size_t len = target_end - target;
+        if (len != 3 || strncasecmp(target, "xml", 3) != 0)
+            return true;   // other processing instructions are ignored
+
+        if (!at_start || std::memcmp(target, "xml", 3) != 0)
+            return false;
+
+        return readPseudoAttributes(target_end, close - 2);
+    }
+
+
+    bool PullParser::readPseudoAttributes(const char *p, const char *last)
+    {
+        static const char *const attributes[] = { "version", "encoding", "standalone" };
+        const std::size_t count = sizeof(attributes) / sizeof(attributes[0]);
+
+        std::size_t next_attr = 0;
+        for (;;)
+        {
+            const char *space = p;
+            while (p != last && isSpace(*p))
+                ++p;
+
+            if (p == last)
+                return next_attr != 0;   // the version is required
+
+            if (p == space)
+                return false;
+
+            const char *attr = p;
+            while (p != last && isNameChar(*p))
+                ++p;
+
+            const std::string_view attr_name(attr, p - attr);
+            while (p != last && isSpace(*p))
+                ++p;
+
+            if (p == last || *p != '=')
+                return false;
+
+            ++p;
+            while (p != last && isSpace(*p))
+                ++p;
+
+            if (p == last || (*p != '"' && *p != '\''))
+                return false;
+
+            const char *quote = static_cast<const char*>(std::memchr(p + 1, *p, last - p - 1));
+            if (quote == 0)
+                return false;
+
+            const std::string_view value(p + 1, quote - p - 1);
+            p = quote + 1;
+
+            // the attributes are optional except the version but their order is fixed
+            std::size_t i = next_attr;
+            while (i < count && attr_name != attributes[i])
+                ++i;
+
+            if (i == count || (next_attr == 0 && i != 0) || value.empty())
+                return false;
+
+            next_attr = i + 1;
+            if (i == 0 && std::find_if_not(value.begin(), value.end(), isNameChar) != value.end())
+                return false;
+
+            if (i == 1
+                && !(value.length() == 5 && strncasecmp(value.data(), "utf-8", 5) == 0)
+                && !(value.length() == 8 && strncasecmp(value.data(), "us-ascii", 8) == 0))
+            {
+                error = eUnknownEncoding;
+                return false;
+            }
+
+            if (i == 2 && value != "yes" && value != "no")
+                return false;
+        }
+    }
+
+
+}  // namespace ulxr
@@ -0,0 +1,195 @@
+/***************************************************************************
+            ulxr_pullparse.h  -  native xml parser for xml-rpc
+                             -------------------
+    begin                : Sat Oct 17 2026
+    copyright            : (C) 2026 by the ulxmlrpcpp developers
+
+    $Id$
+
+ ***************************************************************************/
+
+/**************************************************************************
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ *
+ ***************************************************************************/
+
+#ifndef ULXR_PULLPARSE_H
+#define ULXR_PULLPARSE_H
+
+#include <ulxmlrpcpp/ulxmlrpcpp.h>
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace ulxr {
+
+
+    /** A pull parser for the xml used by xml-rpc.
+      * The input is fed in pieces as it arrives and is scanned where it is,
+      * the events refer to the fed buffer. Only a token which is cut off at
+      * the end of a piece is copied to be completed with the next one.
+      *
+      * The parser checks that the document is well-formed as far as this is
+      * needed to read it safely: tags must match, there must be exactly one
+      * root element and the predefined entities, character references and
+      * CDATA sections are resolved. Document type declarations are rejected,
+      * so there is no entity expansion at all. Attributes are checked for
+      * their syntax and uniqueness and skipped. Line ends in the text are
+      * normalised to LF. The text must consist of valid UTF-8,
+      * so the encoding must be UTF-8 or US-ASCII.
+      * @ingroup grp_ulxr_parser
+      */
+    class  PullParser
+    {
+    public:
+
+        /** The results of \c next().
+          */
+        enum Event
+        {
+            eNeedInput,   //!< the input is used up, \c feed() the next piece
+            eStartTag,    //!< an element was opened, see \c getName()
+            eEndTag,      //!< an element was closed, see \c getName()
+            eText,        //!< some character data, see \c getText()
+            eEnd,         //!< the document is complete
+            eError        //!< the document is not well-formed, see \c getError()
+        };
+
+        /** The reasons why a document is not accepted.
+          */
+        enum Error
+        {
+            eNoError,
+            eSyntaxError,           //!< malformed markup
+            eInvalidToken,          //!< a character which is not allowed or not valid UTF-8
+            eNoElements,            //!< the document has no root element
+            eUnclosedToken,         //!< the document ends too early
+            eTagMismatch,           //!< a closing tag does not match the opening tag
+            eJunkAfterDocElement,   //!< content follows the root element
+            eUndefinedEntity,       //!< an entity which is not predefined
+            eBadCharRef,            //!< a reference to an invalid character
+            eUnsupportedMarkup,     //!< a document type declaration
+            eUnknownEncoding,       //!< an encoding other than UTF-8 or US-ASCII
+            eNestingTooDeep         //!< more than ULXR_MAX_XML_DEPTH nested elements
+        };
+
+        /** Constructs a parser waiting for the start of a document.
+          */
+        PullParser();
+
+        /** Prepares the parser for a new document.
+          */
+        void reset();
+
+        /** Supplies the next piece of the document.
+          * The buffer must stay valid until \c next() has returned
+          * \c eNeedInput or \c eEnd.
+          * @param  data     the start of the piece
+          * @param  len      the length of the piece
+          * @param  isFinal  true: this is the last piece
+          */
+        void feed(const char *data, std::size_t len, bool isFinal);
+
+        /** Reads the next event from the input.
+          * @return the event
+          */
+        Event next();
+
+        /** Gets the name of the element of the current \c eStartTag or \c eEndTag.
+          * The name is valid until the next call to \c next().
+          * @return the name
+          */
+        const char *getName() const;
+
+        /** Gets the character data of the current \c eText.
+          * The text is valid until the next call to \c next().
+          * @return the text
+          */
+        std::string_view getText() const;
+
+        /** Gets the reason why the document was not accepted.
+          * @return the error
+          */
+        Error getError() const;
+
+        /** Gets the description for an error code.
+          * @param  code  the error
+          * @return  the description
+          */
+        static const char *getErrorString(unsigned code);
+
+        /** Gets the current line in the document.
+          * @return  line number, starting with 1
+          */
+        int getLineNumber() const;
+
+    private:
+
+        enum Step
+        {
+            stepEvent,     // a token was read and gives an event
+            stepSkip,      // a token was read without an event
+            stepMore       // the token is cut off
+        };
+
+        Step readText(Event &event);
+        void setText(const char *from, const char *to);
+        Step readReference(Event &event);
+        Error resolveReference(std::string_view entity);
+        Step readMarkup(Event &event);
+        Step readStartTag(Event &event);
+        Step readEndTag(Event &event);
+        bool readDeclaration(const char *close);
+        bool readPseudoAttributes(const char *p, const char *last);
+
+        Event fail(Error err);
+        void consume(const char *to);
+        bool moreInput(char stop);
+
+        const char         *pos;          // the current window of the input
+        const char         *end;
+        const char         *data;         // the rest of the fed piece
+        const char         *data_end;
+        std::string         carry;        // a token cut off at the end of a piece
+        bool                in_carry;     // the window is in carry
+
+        std::string         names;        // the open elements, each terminated by 0
+        std::vector<std::size_t>  name_starts;
+        const char         *name;
+        const char         *text;
+        std::size_t         text_len;
+        std::string         lines;        // text with normalised line ends
+        bool                after_cr;     // the last text ended with a CR
+        std::vector<std::string_view>  attrs;   // the attributes of the current tag
+        char                ref[4];       // a resolved character reference
+
+        bool                final;
+        bool                at_start;
+        bool                root_seen;
+        bool                pending_pop;
+        bool                pending_end;
+        Error               error;
+        int                 line;
+    };
+
+
+}  // namespace ulxr
+
+
+#endif // ULXR_PULLPARSE_H
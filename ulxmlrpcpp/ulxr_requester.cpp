@@ -52,6 +52,9 @@ namespace ulxr {
 
     Requester::Requester(Protocol* prot)
         : protocol(prot)
+        , arena_used(false)
+        , native_used(false)
+        , reused(false)
     {}
 
 
@@ -63,96 +66,133 @@ namespace ulxr {
                                const std::string &rpc_root)
     {
         ULXR_TRACE("send_call " << calldata.getMethodName());
-        if (!protocol->isOpen() )
+
+        // anything arriving on an idle connection means that the
+        // server has closed it
+        if (protocol->isOpen() && protocol->waitForInput(0))
+            protocol->closeConnection();
+
+        reused = protocol->isOpen();
+        if (!reused)
             protocol->open();
         else
             protocol->resetConnection();
-        protocol->sendRpcCall(calldata, rpc_root);
+
+        try
+        {
+            protocol->sendRpcCall(calldata, rpc_root);
+        }
+        catch (...)
+        {
+            protocol->closeConnection();
+            throw;
+        }
     }
 
 
     MethodResponse Requester::waitForResponse()
     {
         ULXR_TRACE("waitForResponse");
-        return waitForResponse(protocol);
+        return waitForResponse(protocol, arena_used, native_used);
     }
 
 
     MethodResponse
-    Requester::waitForResponse(Protocol *protocol)
+    Requester::waitForResponse(Protocol *protocol, bool use_arena, bool use_native)
     {
-        ULXR_TRACE("waitForResponse");
-        char buffer[ULXR_RECV_BUFFER_SIZE];
-        char *buff_ptr;
-
-        std::unique_ptr<XmlParserBase> parser;
-        MethodResponseParserBase *rpb = 0;
-        ULXR_TRACE("waitForResponse in XML");
-        MethodResponseParser *rp = new MethodResponseParser();
-        rpb = rp;
-        parser.reset(rp);
-
-        bool done = false;
-        long myRead;
-        while (!done && protocol->hasBytesToRead()
-                && ((myRead = protocol->readRaw(buffer, sizeof(buffer))) > 0) )
+        bool received;
+        return readResponse(protocol, use_arena, use_native, received);
+    }
+
+
+    MethodResponse
+    Requester::readResponse(Protocol *protocol, bool use_arena, bool use_native, bool &received)
+    {
+        ULXR_TRACE("readResponse");
+        received = false;
+        try
         {
-            buff_ptr = buffer;
-            while (myRead > 0)
+            char buffer[ULXR_RECV_BUFFER_SIZE];
+            char *buff_ptr;
+
+            std::unique_ptr<XmlParserBase> parser;
+            MethodResponseParserBase *rpb = 0;
+            ULXR_TRACE("waitForResponse in XML");
+            MethodResponseParser *rp = new MethodResponseParser();
+            rp->useArena(use_arena);
+            rp->useNativeParser(use_native);
+            rpb = rp;
+            parser.reset(rp);
+
+            bool done = false;
+            long myRead;
+            while (!done && protocol->hasBytesToRead()
+                    && ((myRead = protocol->readRaw(buffer, sizeof(buffer))) > 0) )
             {
-                Protocol::State state = protocol->connectionMachine(buff_ptr, myRead);
-                if (state == Protocol::ConnError)
+                received = true;
+                buff_ptr = buffer;
+                while (myRead > 0)
                 {
-                    done = true;
-                    throw ConnectionException(TransportError, "network problem occured", 400);
-                }
+                    Protocol::State state = protocol->connectionMachine(buff_ptr, myRead);
+                    if (state == Protocol::ConnError)
+                    {
+                        done = true;
+                        throw ConnectionException(TransportError, "network problem occured", 400);
+                    }
 
-                else if (state == Protocol::ConnSwitchToBody)
-                {
+                    else if (state == Protocol::ConnSwitchToBody)
+                    {
 #ifdef ULXR_SHOW_READ
-                    std::string super_data (buff_ptr, myRead);
-                    while ((myRead = protocol->readRaw(buffer, sizeof(buffer))) > 0)
-                        super_data.append(buffer, myRead);
-                    ULXR_DOUT_READ("superdata 3 start:\n");
+                        std::string super_data (buff_ptr, myRead);
+                        while ((myRead = protocol->readRaw(buffer, sizeof(buffer))) > 0)
+                            super_data.append(buffer, myRead);
+                        ULXR_DOUT_READ("superdata 3 start:\n");
 
-                    ULXR_DOUT_READ(super_data);
-                    ULXR_DOUT_READ("superdata 3 end:\n" );
+                        ULXR_DOUT_READ(super_data);
+                        ULXR_DOUT_READ("superdata 3 end:\n" );
 #endif
-                    if (!protocol->hasBytesToRead())
-                    {
-                        throw ConnectionException(NotConformingError,
-                                                  "Content-Length of message not available", 411);
-                    }
+                        if (!protocol->hasBytesToRead())
+                        {
+                            throw ConnectionException(NotConformingError,
+                                                      "Content-Length of message not available", 411);
+                        }
 
-                    std::string s;
-                    if (!protocol->isResponseStatus200(s))
-                        throw ConnectionException(TransportError, s, 500);
+                        std::string s;
+                        if (!protocol->isResponseStatus200(s))
+                            throw ConnectionException(TransportError, s, 500);
 
-                }
+                    }
 
-                else if (state == Protocol::ConnBody)
-                {
-                    ULXR_DOUT_XML(std::string(buff_ptr, myRead));
-                    if (!parser->parse(buff_ptr, myRead, false))
+                    else if (state == Protocol::ConnBody)
                     {
-                        throw XmlException(parser->mapToFaultCode(parser->getErrorCode()),
-                                           "Problem while parsing xml response",
-                                           parser->getCurrentLineNumber(),
-                                           parser->getErrorString(parser->getErrorCode()));
+                        ULXR_DOUT_XML(std::string(buff_ptr, myRead));
+                        if (!parser->parse(buff_ptr, myRead, false))
+                        {
+                            throw XmlException(parser->mapToFaultCode(parser->getErrorCode()),
+                                               "Problem while parsing xml response",
+                                               parser->getCurrentLineNumber(),
+                                               parser->getErrorString(parser->getErrorCode()));
+                        }
+                        myRead = 0;
                     }
-                    myRead = 0;
                 }
-            }
 
-            if (!protocol->hasBytesToRead())
+                if (!protocol->hasBytesToRead())
 //        || parser->isComplete())
-                done = true;
-        }
+                    done = true;
+            }
 
-        if (protocol->isOpen())
-            protocol->closeConnection();
+            if (protocol->isOpen() && !protocol->isKeepAlive())
+                protocol->closeConnection();
 
-        return rpb->getMethodResponse();
+            return rpb->getMethodResponse();
+        }
+        catch (...)
+        {
+            // the state of the connection is unknown
+            protocol->closeConnection();
+            throw;
+        }
     }
 
 
@@ -161,9 +201,7 @@ namespace ulxr {
                      const std::string &user, const std::string &pass)
     {
         ULXR_TRACE("call(..,user, pass)");
-        protocol->setMessageAuthentication(user, pass);
-        send_call (calldata, rpc_root);
-        return waitForResponse();
+        return transmit(calldata, rpc_root, &user, &pass);
     }
 
 
@@ -171,8 +209,59 @@ namespace ulxr {
     Requester::call (const MethodCall& calldata, const std::string &rpc_root)
     {
         ULXR_TRACE("call");
+        return transmit(calldata, rpc_root, 0, 0);
+    }
+
+
+    MethodResponse
+    Requester::transmit (const MethodCall& calldata, const std::string &rpc_root,
+                         const std::string *user, const std::string *pass)
+    {
+        ULXR_TRACE("transmit");
+        bool received = false;
+        try
+        {
+            if (user != 0)
+                protocol->setMessageAuthentication(*user, *pass);
+            send_call (calldata, rpc_root);
+            return readResponse(protocol, arena_used, native_used, received);
+        }
+        catch (ConnectionException &)
+        {
+            // the server may close an idle connection at any time
+            if (!reused || received)
+                throw;
+        }
+
+        ULXR_TRACE("transmit again over a new connection");
+        if (user != 0)
+            protocol->setMessageAuthentication(*user, *pass);
         send_call (calldata, rpc_root);
-        return waitForResponse();
+        return readResponse(protocol, arena_used, native_used, received);
+    }
+
+
+    void Requester::useArena(bool enable)
+    {
+        arena_used = enable;
+    }
+
+
+    bool Requester::isArenaUsed() const
+    {
+        return arena_used;
+    }
+
+
+    void Requester::useNativeParser(bool enable)
+    {
+        native_used = enable;
+    }
+
+
+    bool Requester::isNativeParserUsed() const
+    {
+        return native_used;
     }
 
 }  // namespace ulxr
@@ -47,6 +47,9 @@ namespace ulxr {
       * The requester takes the MethodCall, converts it to xml and sends
       * it over the connection. It then waits for the response which must
       * be further processes by the caller.
+      * With a persistent Protocol the connection is reused for the next call.
+      * If the server has closed it meanwhile, a call which received no
+      * response at all is sent once more over a new connection.
       * @ingroup grp_ulxr_rpc
       */
     class  Requester
@@ -84,10 +87,36 @@ namespace ulxr {
 
 
         /** Waits for the response from the remote server.
-          * @param  conn   connection to wait for data
+          * @param  conn       connection to wait for data
+          * @param  use_arena  parse the response into a ValueArena
+          * @param  use_native read the response with the native \c PullParser
           * @return methode response
           */
-        static MethodResponse waitForResponse(Protocol *conn);
+        static MethodResponse waitForResponse(Protocol *conn, bool use_arena = false,
+                                              bool use_native = false);
+
+        /** Selects if responses are parsed into a ValueArena.
+          * The result is then freed in one go when the last copy
+          * of the MethodResponse is destroyed.
+          * @param  enable  true: use an arena for each response
+          */
+        void useArena(bool enable);
+
+        /** Tests if responses are parsed into a ValueArena.
+          * @return true in arena mode
+          */
+        bool isArenaUsed() const;
+
+        /** Selects if responses are read by the native \c PullParser.
+          * Expat is used by default.
+          * @param  enable  true: use the native parser
+          */
+        void useNativeParser(bool enable);
+
+        /** Tests if responses are read by the native \c PullParser.
+          * @return true if the native parser is used
+          */
+        bool isNativeParserUsed() const;
 
 
     protected:
@@ -104,8 +133,36 @@ namespace ulxr {
         MethodResponse waitForResponse();
 
 
+    private:
+
+        /** Sends a call and waits for the response, see \c call().
+          * @param   call      the data for the call
+          * @param   resource  resource for rpc on remote host
+          * @param   user      user name, NULL for no authentication
+          * @param   pass      password
+          * @return the methods response
+          */
+        MethodResponse transmit(const MethodCall& call,
+                                const std::string &resource,
+                                const std::string *user,
+                                const std::string *pass);
+
+        /** Waits for the response from the remote server.
+          * The connection is closed unless it is kept alive or on errors.
+          * @param  conn       connection to wait for data
+          * @param  use_arena  parse the response into a ValueArena
+          * @param  use_native read the response with the native \c PullParser
+          * @param  received   [OUT] true if any data of the response arrived
+          * @return methode response
+          */
+        static MethodResponse readResponse(Protocol *conn, bool use_arena, bool use_native,
+                                           bool &received);
+
     private:
         Protocol          *protocol;
+        bool               arena_used;
+        bool               native_used;
+        bool               reused;
     };
 
 
@@ -38,6 +38,8 @@
 #include <ulxmlrpcpp/ulxr_response.h>
 #include <ulxmlrpcpp/ulxr_value.h>
 
+#include <utility>
+
 
 namespace ulxr {
 
@@ -67,6 +69,42 @@ namespace ulxr {
     }
 
 
+    MethodResponse::MethodResponse (Value &&val)
+    {
+        setResult (std::move(val));
+    }
+
+
+    MethodResponse::MethodResponse (const MethodResponse &other)
+        : wasOk(other.wasOk)
+        , respval(other.respval)
+    {
+    }
+
+
+    MethodResponse::MethodResponse (MethodResponse &&other)
+        : wasOk(other.wasOk)
+        , respval(std::move(other.respval))
+    {
+    }
+
+
+    MethodResponse& MethodResponse::operator= (const MethodResponse &other)
+    {
+        wasOk = other.wasOk;
+        respval = other.respval;
+        return *this;
+    }
+
+
+    MethodResponse& MethodResponse::operator= (MethodResponse &&other)
+    {
+        wasOk = other.wasOk;
+        respval = std::move(other.respval);
+        return *this;
+    }
+
+
     MethodResponse::~MethodResponse()
     {
     }
@@ -85,7 +123,7 @@ namespace ulxr {
         Struct st;
         st.addMember("faultCode", Integer(fval));
         st.addMember("faultString", RpcString(fstr));
-        respval = st;
+        respval = std::move(st);
     }
 
 
@@ -97,6 +135,14 @@ namespace ulxr {
     }
 
 
+    void MethodResponse::setResult (Value &&val)
+    {
+        ULXR_TRACE("setResult");
+        wasOk = true;
+        respval = std::move(val);
+    }
+
+
     const Value& MethodResponse::getResult() const
     {
         return respval;
@@ -111,30 +157,90 @@ namespace ulxr {
 
     std::string MethodResponse::getXml(int indent) const
     {
-        std::string ind = getXmlIndent(indent);
-        std::string ind1 = getXmlIndent(indent+1);
-        std::string ind2 = getXmlIndent(indent+2);
-        std::string s = "<?xml version=\"1.0\" encoding=\"utf-8\"?>" + getXmlLinefeed();
-        s += ind + "<methodResponse>" + getXmlLinefeed();
+        return getXml(XmlWriterOptions(), indent);
+    }
+
+
+    std::string MethodResponse::getXml(const XmlWriterOptions &options, int indent) const
+    {
+        std::string s;
+        s.reserve(getXmlSize(options, indent));
+        XmlSink sink(s, options);
+        serialize(sink, indent);
+        return s;
+    }
+
+
+    void MethodResponse::serialize(XmlSink &sink, int indent) const
+    {
+        if (sink.getOptions().hasXmlDeclaration())
+        {
+            sink.append("<?xml version=\"1.0\" encoding=\"utf-8\"?>");
+            sink.appendLinefeed();
+        }
+        sink.appendIndent(indent);
+        sink.append("<methodResponse>");
+        sink.appendLinefeed();
         if (wasOk)
         {
-            s += ind1 + "<params>" + getXmlLinefeed();
+            sink.appendIndent(indent+1);
+            sink.append("<params>");
+            sink.appendLinefeed();
             if (!respval.isVoid())
             {
-                s += ind2 + "<param>" + getXmlLinefeed();
-                s += respval.getXml(indent+3) + getXmlLinefeed();
-                s += ind2 + "</param>" + getXmlLinefeed();
+                sink.appendIndent(indent+2);
+                sink.append("<param>");
+                sink.appendLinefeed();
+                respval.serialize(sink, indent+3);
+                sink.appendLinefeed();
+                sink.appendIndent(indent+2);
+                sink.append("</param>");
+                sink.appendLinefeed();
             }
-            s += ind1 + "</params>" + getXmlLinefeed();
+            sink.appendIndent(indent+1);
+            sink.append("</params>");
+            sink.appendLinefeed();
         }
         else
         {
-            s += ind1 + "<fault>" + getXmlLinefeed();
-            s += respval.getXml(indent+2) +  getXmlLinefeed();
-            s += ind1 + "</fault>" + getXmlLinefeed();
+            sink.appendIndent(indent+1);
+            sink.append("<fault>");
+            sink.appendLinefeed();
+            respval.serialize(sink, indent+2);
+            sink.appendLinefeed();
+            sink.appendIndent(indent+1);
+            sink.append("</fault>");
+            sink.appendLinefeed();
         }
-        s += ind + "</methodResponse>";
-        return s;
+        sink.appendIndent(indent);
+        sink.append("</methodResponse>");
+    }
+
+
+    std::size_t MethodResponse::getXmlSize(int indent) const
+    {
+        return getXmlSize(XmlWriterOptions(), indent);
+    }
+
+
+    std::size_t MethodResponse::getXmlSize(const XmlWriterOptions &options, int indent) const
+    {
+        const std::size_t lf = options.getLinefeedSize();
+        std::size_t size = options.getIndentSize(indent) * 2 + options.getIndentSize(indent+1) * 2
+                         + lf + sizeof("<methodResponse></methodResponse>") - 1;
+        if (options.hasXmlDeclaration())
+            size += sizeof("<?xml version=\"1.0\" encoding=\"utf-8\"?>") - 1 + lf;
+        if (wasOk)
+        {
+            size += lf * 2 + sizeof("<params></params>") - 1;
+            if (!respval.isVoid())
+                size += options.getIndentSize(indent+2) * 2 + lf * 3
+                      + sizeof("<param></param>") - 1 + respval.getXmlSize(options, indent+3);
+        }
+        else
+            size += lf * 3 + sizeof("<fault></fault>") - 1 + respval.getXmlSize(options, indent+2);
+
+        return size;
     }
 
 
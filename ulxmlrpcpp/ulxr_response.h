@@ -73,6 +73,32 @@ namespace ulxr {
           */
         MethodResponse (const Value &val);
 
+        /** Constructs a return value from the remote method by taking
+          * over the content of the value.
+          * @param  val   the return value.
+          */
+        MethodResponse (Value &&val);
+
+        /** Creates a response as duplicate of another response.
+          * @param  other  the source response
+          */
+        MethodResponse (const MethodResponse &other);
+
+        /** Creates a response by taking over the content of another response.
+          * @param  other  the source response
+          */
+        MethodResponse (MethodResponse &&other);
+
+        /** Copies the content of another response.
+          * @param  other  the source response
+          */
+        MethodResponse &operator= (const MethodResponse &other);
+
+        /** Takes over the content of another response.
+          * @param  other  the source response
+          */
+        MethodResponse &operator= (MethodResponse &&other);
+
         /** Constructs an empty return value from the remote method.
           * Only exists for completeness and yields the same as the default constructor.
           * @param  val   the return value.
@@ -105,6 +131,34 @@ namespace ulxr {
           */
         virtual std::string getXml(int indent = 0) const;
 
+        /** Returns the response as xml string.
+          * @param  options  settings for the generated xml
+          * @param  indent   current indentation level
+          * @return  The xml content
+          */
+        std::string getXml(const XmlWriterOptions &options, int indent = 0) const;
+
+        /** Writes the response as xml to a sink.
+          * The method response is converted to an xml text like \c getXml() does.
+          * @param  sink     receives the xml content
+          * @param  indent   current indentation level
+          */
+        virtual void serialize(XmlSink &sink, int indent = 0) const;
+
+        /** Returns the size of the xml which \c serialize() writes
+          * with the process wide settings.
+          * @param  indent   current indentation level
+          * @return  number of characters
+          */
+        std::size_t getXmlSize(int indent = 0) const;
+
+        /** Returns the size of the xml which \c serialize() writes.
+          * @param  options  settings for the generated xml
+          * @param  indent   current indentation level
+          * @return  number of characters
+          */
+        virtual std::size_t getXmlSize(const XmlWriterOptions &options, int indent = 0) const;
+
         /** Constructs a "fault reponse" to indicate RPC problems.
           * The number and string are system dependent.
           * @param  fval   error code
@@ -119,6 +173,12 @@ namespace ulxr {
           */
         void setResult (const Value &val);
 
+        /** Sets the return value from the remote method by taking
+          * over the content of the value.
+          * @param  val   the return value.
+          */
+        void setResult (Value &&val);
+
         /** Gets the return value from the remote method.
           * The value can be of any type, even an Array or a Struct.
           * If the response is faulty, is contains a Struct with two elements:
@@ -33,7 +33,6 @@
 
 #include <ulxmlrpcpp/ulxmlrpcpp.h>
 
-#include <cstring>
 #include <memory>
 
 #include <ulxmlrpcpp/ulxr_responseparse.h>
@@ -59,46 +58,47 @@ namespace ulxr {
                    << name
                   );
 
-        switch(states.top()->getParserState() )
+        const Tag tag = getTag(name);
+        switch(getTopValueState()->getParserState() )
         {
         case eNone:
-            if(strcmp(name, "methodResponse") == 0)
+            if(tag == eTagMethodResponse)
             {
                 setComplete (false);
-                states.push(new ValueState(eMethodResponse));
+                pushState(eMethodResponse);
             }
             else
                 return false;
             break;
 
         case eMethodResponse:
-            if(strcmp(name, "fault") == 0)
-                states.push(new ValueState(eFault));
+            if(tag == eTagFault)
+                pushState(eFault);
 
-            else if(strcmp(name, "params") == 0)
-                states.push(new ValueState(eParams));
+            else if(tag == eTagParams)
+                pushState(eParams);
 
             else
                 return false;
             break;
 
         case eFault:
-            if(strcmp(name, "value") == 0)
-                states.push(new ValueState(eValue));
+            if(tag == eTagValue)
+                pushState(eValue);
             else
                 return false;
             break;
 
         case eParams:
-            if(strcmp(name, "param") == 0)
-                states.push(new ValueState(eParam));
+            if(tag == eTagParam)
+                pushState(eParam);
             else
                 return false;
             break;
 
         case eParam:
-            if(strcmp(name, "value") == 0)
-                states.push(new ValueState(eValue));
+            if(tag == eTagValue)
+                pushState(eValue);
             else
                 return false;
             break;
@@ -122,43 +122,42 @@ namespace ulxr {
     {
         ULXR_TRACE("MethodResponseParser::testEndElement(const XML_Char*)");
 
-        if (states.size() <= 1)
+        if (numStates() <= 1)
             throw RuntimeException(ApplicationError, "abnormal program behaviour: MethodResponseParser::testEndElement() had no states left");
 
-        std::unique_ptr<ValueState> curr(getTopValueState());
-        states.pop();
-        ValueState *on_top = getTopValueState();
+        ValueState *curr = getTopValueState();
+        ValueState *on_top = getParentValueState();
 
         switch(curr->getParserState() )
         {
         case eMethodResponse:
             setComplete(true);
-            assertEndElement(name, "methodResponse");
-            on_top->takeValue (curr->getValue());
-            if (on_top->getValue() != 0)
-                method_value = *on_top->getValue();
+            assertEndElement(name, eTagMethodResponse);
+            on_top->takeValue (curr->releaseValue());
+            if (on_top->hasValue())
+                method_value = on_top->getValue();
             break;
 
         case eFault:
-            assertEndElement(name, "fault");
-            on_top->takeValue (curr->getValue());
+            assertEndElement(name, eTagFault);
+            on_top->takeValue (curr->releaseValue());
             break;
 
         case eParams:
-            assertEndElement(name, "params");
-            on_top->takeValue (curr->getValue());
+            assertEndElement(name, eTagParams);
+            on_top->takeValue (curr->releaseValue());
             break;
 
         case eParam:
-            assertEndElement(name, "param");
-            on_top->takeValue (curr->getValue());
+            assertEndElement(name, eTagParam);
+            on_top->takeValue (curr->releaseValue());
             break;
 
         default:
-            states.push(curr.release());   // put back, someone else will process
-            return false;
+            return false;   // someone else will process
         }
 
+        popState();
         return true;
     }
 
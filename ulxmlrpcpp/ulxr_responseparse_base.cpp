@@ -44,7 +44,7 @@ namespace ulxr {
     {
         if (method_value.isStruct() )
         {
-            Struct st = method_value;
+            const Struct &st = static_cast<const Value&>(method_value);
             if (   st.size() == 2
                     && st.hasMember("faultCode")
                     && st.hasMember("faultString") )
@@ -41,6 +41,7 @@
 #include <openssl/ssl.h>
 #include <string.h>
 #include <sstream>
+#include <algorithm>
 
 #ifndef __OpenBSD__
 #ifndef strlcpy
@@ -234,6 +235,26 @@ namespace ulxr {
     }
 
 
+    size_t SSLConnection::low_level_writev(const iovec *iov, int count)
+    {
+        ULXR_TRACE("SSLConnection::low_level_writev " << count);
+
+        // the largest payload of a single tls record
+        const std::size_t record_size = 16 * 1024;
+
+        if (count == 1 || iov[0].iov_len >= record_size)
+            return low_level_write((const char*) iov[0].iov_base, iov[0].iov_len);
+
+        writeBuffer.clear();
+        for (int i = 0; i < count && writeBuffer.length() < record_size; ++i)
+        {
+            const std::size_t len = std::min(iov[i].iov_len, record_size - writeBuffer.length());
+            writeBuffer.append((const char*) iov[i].iov_base, len);
+        }
+        return low_level_write(writeBuffer.data(), writeBuffer.length());
+    }
+
+
     bool SSLConnection::hasPendingInput() const
     {
         const int avail = SSL_pending(theSSL);
@@ -109,6 +109,7 @@ namespace ulxr {
         std::string   password;
         std::string   keyfile;
         std::string   certfile;
+        std::string   writeBuffer;
 
         static bool SSL_initialized;
 
@@ -127,6 +128,15 @@ namespace ulxr {
           */
         size_t virtual low_level_write(char const *buff, long len);
 
+        /** Actually writes several pieces of data to the connection.
+          * SSL has no vectored write, so small pieces are collected
+          * and encrypted together into one record.
+          * @param  iov    the pieces in the order to write
+          * @param  count  number of pieces, at least one
+          * @return  number of bytes written
+          */
+        size_t virtual low_level_writev(const iovec *iov, int count);
+
         /** Reads data from the connection.
           * @param  buff pointer to data buffer
           * @param  len  maimum number of bytes to read into buffer
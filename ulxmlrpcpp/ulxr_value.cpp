@@ -31,13 +31,23 @@
 #include <ulxmlrpcpp/ulxmlrpcpp.h>
 
 #include <cstdio>
+#include <charconv>
 #include <ctime>
 #include <vector>
 #include <iostream>
 #include <cstdlib>
+#include <utility>
+#include <new>
+#include <algorithm>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
 
 #include <ulxmlrpcpp/ulxr_value.h>
+#include <ulxmlrpcpp/ulxr_arena.h>
+#include <ulxmlrpcpp/ulxr_base64.h>
 #include <ulxmlrpcpp/ulxr_except.h>
+#include <ulxmlrpcpp/ulxr_valueparse.h>
 
 
 #define ULXR_ASSERT_RPCTYPE(x) \
@@ -53,6 +63,104 @@
 namespace ulxr {
 
 
+    namespace
+    {
+
+        void serializeBoolean(XmlSink &sink, bool b)
+        {
+            if (b)
+                sink.append("<value><boolean>1</boolean></value>"); // "true"
+            else
+                sink.append("<value><boolean>0</boolean></value>"); // "false"
+        }
+
+
+        // strips what from_chars() does not accept
+        std::string_view trimNumber(std::string_view s)
+        {
+            const char *ws = " \t\r\n";
+            const std::size_t first = s.find_first_not_of(ws);
+            if (first == std::string_view::npos)
+                return std::string_view();
+
+            s = s.substr(first, s.find_last_not_of(ws) - first + 1);
+            if (s.length() > 1 && s[0] == '+' && s[1] != '-')
+                s.remove_prefix(1);
+            return s;
+        }
+
+
+        const std::size_t booleanXmlSize = sizeof("<value><boolean>0</boolean></value>") - 1;
+
+
+        void serializeInteger(XmlSink &sink, int i)
+        {
+            sink.append("<value><i4>");
+
+            char buff[16];
+            sink.append(std::string_view(buff, std::to_chars(buff, buff + sizeof(buff), i).ptr - buff));
+            sink.append("</i4></value>");
+        }
+
+
+        std::size_t getIntegerXmlSize(int i)
+        {
+            std::size_t size = sizeof("<value><i4></i4></value>") - 1;
+            unsigned u = static_cast<unsigned>(i);
+            if (i < 0)
+            {
+                u = 0u - u;
+                ++size;
+            }
+
+            do
+            {
+                ++size;
+                u /= 10;
+            } while (u != 0);
+            return size;
+        }
+
+
+        unsigned formatDouble(char *buff, std::size_t len, double d, Double::Format format)
+        {
+            unsigned used;
+            if (format == Double::ShortestFormat)
+            {
+                std::to_chars_result res = std::to_chars(buff, buff + len, d, std::chars_format::fixed);
+                used = res.ec == std::errc() ? res.ptr - buff : len;
+            }
+            else if (format == Double::ScientificFormat)
+                used = snprintf(buff, len, "%g", d);
+            else
+                used = snprintf(buff, len, "%f", d);
+
+            if (used >= len)
+                throw RuntimeException(ApplicationError,  "Buffer for conversion too small in Double::serialize ");
+
+            return used;
+        }
+
+
+        void serializeDouble(XmlSink &sink, double d, Double::Format format)
+        {
+            sink.append("<value><double>");
+            char buff[1000];
+            sink.append(std::string_view(buff, formatDouble(buff, sizeof(buff), d, format)));
+            sink.append("</double></value>");
+        }
+
+
+        std::size_t getDoubleXmlSize(double d, Double::Format format)
+        {
+            char buff[1000];
+            return sizeof("<value><double></double></value>") - 1
+                 + formatDouble(buff, sizeof(buff), d, format);
+        }
+
+    }
+
+
 
 //////////////////////////////////////////////////////
 
@@ -111,6 +219,12 @@ namespace ulxr {
     }
 
 
+    bool Value::isRawXml() const
+    {
+        return baseVal->isRawXml();
+    }
+
+
     ValueType Value::getType() const
     {
         return baseVal->getType();
@@ -133,17 +247,46 @@ namespace ulxr {
 
 
     std::string Value::getXml(int indent) const
+    {
+        return getXml(XmlWriterOptions(), indent);
+    }
+
+
+    std::string Value::getXml(const XmlWriterOptions &options, int indent) const
     {
         std::string ret;
-        if (baseVal != 0)
-            ret = baseVal->getXml(indent);
+        ret.reserve(getXmlSize(options, indent));
+        XmlSink sink(ret, options);
+        serialize(sink, indent);
         return ret;
     }
 
 
+    void Value::serialize(XmlSink &sink, int indent) const
+    {
+        if (baseVal != 0)
+            baseVal->serialize(sink, indent);
+    }
+
+
+    std::size_t Value::getXmlSize(int indent) const
+    {
+        return getXmlSize(XmlWriterOptions(), indent);
+    }
+
+
+    std::size_t Value::getXmlSize(const XmlWriterOptions &options, int indent) const
+    {
+        if (baseVal != 0)
+            return baseVal->getXmlSize(options, indent);
+        return 0;
+    }
+
+
     Struct* Value::getStruct()
     {
         ULXR_ASSERT_RPCTYPE(RpcStruct);
+        unshare();
         return structVal;
     };
 
@@ -158,6 +301,7 @@ namespace ulxr {
     Array* Value::getArray()
     {
         ULXR_ASSERT_RPCTYPE(RpcArray);
+        unshare();
         return arrayVal;
     };
 
@@ -169,9 +313,26 @@ namespace ulxr {
     };
 
 
+    Struct* Value::modifyStruct()
+    {
+        ULXR_ASSERT_RPCTYPE(RpcStruct);
+        detach();
+        return structVal;
+    }
+
+
+    Array* Value::modifyArray()
+    {
+        ULXR_ASSERT_RPCTYPE(RpcArray);
+        detach();
+        return arrayVal;
+    }
+
+
     Value::operator Boolean& ()
     {
         ULXR_ASSERT_RPCTYPE(RpcBoolean);
+        unshare();
         return *boolVal;
     }
 
@@ -186,6 +347,7 @@ namespace ulxr {
     Value::operator Integer& ()
     {
         ULXR_ASSERT_RPCTYPE(RpcInteger);
+        unshare();
         return *intVal;
     }
 
@@ -200,6 +362,7 @@ namespace ulxr {
     Value::operator Double& ()
     {
         ULXR_ASSERT_RPCTYPE(RpcDouble);
+        unshare();
         return *doubleVal;
     }
 
@@ -214,6 +377,7 @@ namespace ulxr {
     Value::operator Array& ()
     {
         ULXR_ASSERT_RPCTYPE(RpcArray);
+        unshare();
         return *arrayVal;
     }
 
@@ -228,6 +392,7 @@ namespace ulxr {
     Value::operator Struct& ()
     {
         ULXR_ASSERT_RPCTYPE(RpcStruct);
+        unshare();
         return *structVal;
     }
 
@@ -242,6 +407,7 @@ namespace ulxr {
     Value::operator RpcString& ()
     {
         ULXR_ASSERT_RPCTYPE(RpcStrType);
+        unshare();
         return *stringVal;
     }
 
@@ -256,6 +422,7 @@ namespace ulxr {
     Value::operator Base64& ()
     {
         ULXR_ASSERT_RPCTYPE(RpcBase64);
+        unshare();
         return *base64Val;
     }
 
@@ -270,6 +437,7 @@ namespace ulxr {
     Value::operator DateTime& ()
     {
         ULXR_ASSERT_RPCTYPE(RpcDateTime);
+        unshare();
         return *dateVal;
     }
 
@@ -281,33 +449,46 @@ namespace ulxr {
     }
 
 
+    Value::operator const RawXml& () const
+    {
+        ULXR_ASSERT_RPCTYPE(RpcRawXml);
+        return *rawVal;
+    }
+
+
     Value::Value ()
     {
-        voidVal = new Void();
+        voidVal = new (inlineData) Void();
     }
 
 
     Value::Value (const Value &val)
     {
-        baseVal = val.baseVal->cloneValue();
+        acquire(val);
+    }
+
+
+    Value::Value (Value &&val) noexcept
+    {
+        takeOver(val);
     }
 
 
     Value::Value (const Boolean &val)
     {
-        boolVal = new Boolean(val);
+        boolVal = new (inlineData) Boolean(val);
     }
 
 
     Value::Value (const Integer &val)
     {
-        intVal = new Integer(val);
+        intVal = new (inlineData) Integer(val);
     }
 
 
     Value::Value (const Double &val)
     {
-        doubleVal = new Double(val);
+        doubleVal = new (inlineData) Double(val);
     }
 
 
@@ -317,24 +498,48 @@ namespace ulxr {
     }
 
 
+    Value::Value (Array &&val)
+    {
+        arrayVal = new Array(std::move(val));
+    }
+
+
     Value::Value (const Struct &val)
     {
         structVal = new Struct(val);
     }
 
 
+    Value::Value (Struct &&val)
+    {
+        structVal = new Struct(std::move(val));
+    }
+
+
     Value::Value (const RpcString &val)
     {
         stringVal = new RpcString(val);
     }
 
 
+    Value::Value (RpcString &&val)
+    {
+        stringVal = new RpcString(std::move(val));
+    }
+
+
     Value::Value (const Base64 &val)
     {
         base64Val = new Base64(val);
     }
 
 
+    Value::Value (Base64 &&val)
+    {
+        base64Val = new Base64(std::move(val));
+    }
+
+
 
     Value::Value (const DateTime &val)
     {
@@ -342,6 +547,18 @@ namespace ulxr {
     }
 
 
+    Value::Value (const RawXml &val)
+    {
+        rawVal = new RawXml(val);
+    }
+
+
+    Value::Value (RawXml &&val)
+    {
+        rawVal = new RawXml(std::move(val));
+    }
+
+
 
     Value::Value (const char *val)
     {
@@ -350,27 +567,41 @@ namespace ulxr {
 
     Value::Value (const double &val)
     {
-        doubleVal = new Double(val);
+        doubleVal = new (inlineData) Double(val);
     }
 
 
     Value::Value (const int &val)
     {
-        intVal = new Integer(val);
+        intVal = new (inlineData) Integer(val);
     }
 
 
     Value::Value (const bool &val)
     {
-        boolVal = new Boolean(val);
+        boolVal = new (inlineData) Boolean(val);
     }
 
 
     Value& Value::operator= (const Value &val)
     {
-        ValueBase *temp = val.baseVal->cloneValue();
-        delete baseVal;
-        baseVal = temp;
+        if (this != &val)
+        {
+            Value temp(val);
+            release();
+            takeOver(temp);
+        }
+        return *this;
+    }
+
+
+    Value& Value::operator= (Value &&val) noexcept
+    {
+        if (this != &val)
+        {
+            release();
+            takeOver(val);
+        }
         return *this;
     }
 
@@ -378,17 +609,158 @@ namespace ulxr {
     Value::~Value ()
 
     {
-        delete baseVal;
+        release();
+    }
+
+
+    bool Value::isInline() const
+    {
+        switch (baseVal->getType())
+        {
+        case RpcVoid:
+        case RpcBoolean:
+        case RpcInteger:
+        case RpcDouble:
+            return true;
+
+        default:
+            return false;
+        }
+    }
+
+
+    void Value::copyInline(const ValueBase *node)
+    {
+        static_assert(   sizeof(Void) <= InlineSize && sizeof(Boolean) <= InlineSize
+                      && sizeof(Integer) <= InlineSize && sizeof(Double) <= InlineSize,
+                      "inline storage of Value too small");
+
+        switch (node->getType())
+        {
+        case RpcBoolean:
+            boolVal = new (inlineData) Boolean(*static_cast<const Boolean*>(node));
+            break;
+
+        case RpcInteger:
+            intVal = new (inlineData) Integer(*static_cast<const Integer*>(node));
+            break;
+
+        case RpcDouble:
+            doubleVal = new (inlineData) Double(*static_cast<const Double*>(node));
+            break;
+
+        default:
+            voidVal = new (inlineData) Void();
+            break;
+        }
+    }
+
+
+    void Value::acquire(const Value &val)
+    {
+        if (val.isInline())
+            copyInline(val.baseVal);
+
+        else if (!val.baseVal->shareable)
+            baseVal = val.baseVal->cloneValue();
+
+        else
+        {
+            val.baseVal->refs.fetch_add(1, std::memory_order_relaxed);
+            baseVal = val.baseVal;
+        }
+    }
+
+
+    void Value::takeOver(Value &val)
+    {
+        if (val.isInline())
+        {
+            copyInline(val.baseVal);
+            val.baseVal->~ValueBase();
+        }
+        else
+            baseVal = val.baseVal;
+
+        val.voidVal = new (val.inlineData) Void();
+    }
+
+
+    void Value::release()
+    {
+        if (isInline())
+            baseVal->~ValueBase();
+
+        else if (baseVal->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            if (baseVal->inArena)
+                ValueArena::destroy(baseVal);
+            else
+                delete baseVal;
+        }
+
         baseVal = 0;
     }
 
 
+    void Value::detach()
+    {
+        if (!isInline() && baseVal->refs.load(std::memory_order_acquire) != 1)
+        {
+            ValueBase *temp = baseVal->cloneValue();
+            release();
+            baseVal = temp;
+        }
+    }
+
+
+    void Value::unshare()
+    {
+        if (!isInline() && baseVal->inArena)
+        {
+            ValueBase *temp = baseVal->cloneValue();
+            release();
+            baseVal = temp;
+        }
+        else
+            detach();
+
+        baseVal->shareable = false;
+    }
+
+
+    void Value::adopt(ValueBase *node)
+    {
+        release();
+        baseVal = node;
+    }
+
+
 //////////////////////////////////////////////////////
 
 
     ValueBase::ValueBase (ValueType t)
-        : type(t)
+        : refs(1)
+        , type(t)
+        , shareable(true)
+        , inArena(false)
+    {
+    }
+
+
+    ValueBase::ValueBase (const ValueBase &other)
+        : refs(1)
+        , type(other.type)
+        , shareable(true)
+        , inArena(false)
+    {
+    }
+
+
+    ValueBase &ValueBase::operator= (const ValueBase &other)
     {
+        type = other.type;
+        return *this;
     }
 
 
@@ -457,6 +829,28 @@ namespace ulxr {
     }
 
 
+    bool ValueBase::isRawXml() const
+    {
+        return type == RpcRawXml;
+    }
+
+
+    std::string ValueBase::getXml(int indent) const
+    {
+        return getXml(XmlWriterOptions(), indent);
+    }
+
+
+    std::string ValueBase::getXml(const XmlWriterOptions &options, int indent) const
+    {
+        std::string ret;
+        ret.reserve(getXmlSize(options, indent));
+        XmlSink sink(ret, options);
+        serialize(sink, indent);
+        return ret;
+    }
+
+
     std::string ValueBase::getTypeName() const
     {
         std::string ret = "RpcValue";
@@ -497,6 +891,10 @@ namespace ulxr {
         case RpcStruct:
             ret = "RpcStruct";
             break;
+
+        case RpcRawXml:
+            ret = "RpcRawXml";
+            break;
         }
         return ret;
     }
@@ -535,10 +933,16 @@ namespace ulxr {
         return "void";
     }
 
-    std::string Void::getXml(int /*indent*/) const
+    void Void::serialize(XmlSink & /*sink*/, int /*indent*/) const
     {
         ULXR_ASSERT_RPCTYPE(RpcVoid);
-        return "";
+    }
+
+
+    std::size_t Void::getXmlSize(const XmlWriterOptions &/*options*/, int /*indent*/) const
+    {
+        ULXR_ASSERT_RPCTYPE(RpcVoid);
+        return 0;
     }
 
 
@@ -547,6 +951,7 @@ namespace ulxr {
 
     Boolean::Boolean ()
         : ValueBase(RpcBoolean)
+        , val(false)
     {
     }
 
@@ -593,19 +998,18 @@ namespace ulxr {
     }
 
 
-    std::string Boolean::getXml(int indent) const
+    void Boolean::serialize(XmlSink &sink, int indent) const
     {
         ULXR_ASSERT_RPCTYPE(RpcBoolean);
-        std::string s = getXmlIndent(indent);
-        s += "<value><boolean>";
+        sink.appendIndent(indent);
+        serializeBoolean(sink, val);
+    }
 
-        if (val)
-            s += "1"; // "true"
-        else
-            s += "0"; // "false"
 
-        s += "</boolean></value>";
-        return s;
+    std::size_t Boolean::getXmlSize(const XmlWriterOptions &options, int indent) const
+    {
+        ULXR_ASSERT_RPCTYPE(RpcBoolean);
+        return options.getIndentSize(indent) + booleanXmlSize;
     }
 
 
@@ -628,6 +1032,7 @@ namespace ulxr {
 
     Integer::Integer ()
         : ValueBase(RpcInteger)
+        , val(0)
     {
     }
 
@@ -646,11 +1051,17 @@ namespace ulxr {
     Integer::Integer (const std::string &s)
         : ValueBase(RpcInteger)
     {
-//  val = atoi(s.c_str() );
-        char *endp;
-        val = strtol(s.c_str(), &endp, 10 );
-//  if (*endp != 0)
-// FIXME
+        if (!parse(s, val))
+            throw ParameterException(ApplicationError, "Integer: no valid number: " + s);
+    }
+
+
+    bool Integer::parse(std::string_view s, int &i)
+    {
+        s = trimNumber(s);
+        const char *end = s.data() + s.length();
+        std::from_chars_result res = std::from_chars(s.data(), end, i);
+        return res.ec == std::errc() && res.ptr == end;
     }
 
 
@@ -675,19 +1086,18 @@ namespace ulxr {
     }
 
 
-    std::string Integer::getXml(int indent) const
+    void Integer::serialize(XmlSink &sink, int indent) const
     {
         ULXR_ASSERT_RPCTYPE(RpcInteger);
-        std::string s = getXmlIndent(indent);
-        s += "<value><i4>";
+        sink.appendIndent(indent);
+        serializeInteger(sink, val);
+    }
 
-        char buff[100];
-        if (snprintf(buff, sizeof(buff), "%d", val) >= (int) sizeof(buff))
-            throw RuntimeException(ApplicationError, "Buffer for conversion too small in Integer::getXml() ");
 
-        s += buff;
-        s += "</i4></value>";
-        return s;
+    std::size_t Integer::getXmlSize(const XmlWriterOptions &options, int indent) const
+    {
+        ULXR_ASSERT_RPCTYPE(RpcInteger);
+        return options.getIndentSize(indent) + getIntegerXmlSize(val);
     }
 
 
@@ -708,11 +1118,12 @@ namespace ulxr {
 //////////////////////////////////////////////////////
 
 
-    bool Double::scientific = false;
+    std::atomic<Double::Format> Double::format(Double::FixedFormat);
 
 
     Double::Double ()
         : ValueBase(RpcDouble)
+        , val(0.0)
     {
     }
 
@@ -732,7 +1143,17 @@ namespace ulxr {
     Double::Double (const std::string &s)
         : ValueBase(RpcDouble)
     {
-        val = atof(s.c_str() );
+        if (!parse(s, val))
+            throw ParameterException(ApplicationError, "Double: no valid number: " + s);
+    }
+
+
+    bool Double::parse(std::string_view s, double &d)
+    {
+        s = trimNumber(s);
+        const char *end = s.data() + s.length();
+        std::from_chars_result res = std::from_chars(s.data(), end, d);
+        return res.ec == std::errc() && res.ptr == end;
     }
 
 
@@ -758,31 +1179,40 @@ namespace ulxr {
 
     bool Double::setScientificMode(bool in_scientific)
     {
-        bool prev = scientific;
-        scientific = in_scientific;
-        return prev;
+        return setFormat(in_scientific ? ScientificFormat : FixedFormat) == ScientificFormat;
     }
 
 
-    std::string Double::getXml(int indent) const
+    bool Double::getScientificMode()
     {
-        ULXR_ASSERT_RPCTYPE(RpcDouble);
-        std::string s = getXmlIndent(indent);
-        s += "<value><double>";
-        char buff[1000];
+        return getFormat() == ScientificFormat;
+    }
 
-        unsigned used;
-        if (scientific)
-            used = snprintf(buff, sizeof(buff), "%g", val);
-        else
-            used = snprintf(buff, sizeof(buff), "%f", val);
 
-        if (used >= sizeof(buff))
-            throw RuntimeException(ApplicationError,  "Buffer for conversion too small in Double::getXml ");
+    Double::Format Double::setFormat(Format in_format)
+    {
+        return format.exchange(in_format, std::memory_order_relaxed);
+    }
 
-        s += buff;
-        s += "</double></value>";
-        return s;
+
+    Double::Format Double::getFormat()
+    {
+        return format.load(std::memory_order_relaxed);
+    }
+
+
+    void Double::serialize(XmlSink &sink, int indent) const
+    {
+        ULXR_ASSERT_RPCTYPE(RpcDouble);
+        sink.appendIndent(indent);
+        serializeDouble(sink, val, sink.getOptions().getDoubleFormat());
+    }
+
+
+    std::size_t Double::getXmlSize(const XmlWriterOptions &options, int indent) const
+    {
+        ULXR_ASSERT_RPCTYPE(RpcDouble);
+        return options.getIndentSize(indent) + getDoubleXmlSize(val, options.getDoubleFormat());
     }
 
 
@@ -816,20 +1246,55 @@ namespace ulxr {
     }
 
 
-    RpcString::~RpcString ()
+    RpcString::RpcString (std::pmr::memory_resource *resource, const std::string &s)
+        : ValueBase(RpcStrType)
+        , val(s, resource)
     {
     }
 
-    ValueBase * RpcString::cloneValue() const
+
+    RpcString::RpcString (const RpcString &other)
+        : ValueBase(other)
+        , val(other.val)
     {
-        ULXR_ASSERT_RPCTYPE(RpcStrType);
-        return new RpcString(*this);
     }
 
 
-    std::string RpcString::getSignature(bool /*deep*/) const
+    RpcString::RpcString (RpcString &&other)
+        : ValueBase(other)
+        , val(std::move(other.val), std::pmr::get_default_resource())
     {
-        ULXR_ASSERT_RPCTYPE(RpcStrType);
+    }
+
+
+    RpcString::~RpcString ()
+    {
+    }
+
+
+    RpcString &RpcString::operator= (const RpcString &other)
+    {
+        val = other.val;
+        return *this;
+    }
+
+
+    RpcString &RpcString::operator= (RpcString &&other)
+    {
+        val = std::move(other.val);
+        return *this;
+    }
+
+    ValueBase * RpcString::cloneValue() const
+    {
+        ULXR_ASSERT_RPCTYPE(RpcStrType);
+        return new RpcString(*this);
+    }
+
+
+    std::string RpcString::getSignature(bool /*deep*/) const
+    {
+        ULXR_ASSERT_RPCTYPE(RpcStrType);
         return getValueName();
     }
 
@@ -840,21 +1305,29 @@ namespace ulxr {
     }
 
 
-    std::string RpcString::getXml(int indent) const
+    void RpcString::serialize(XmlSink &sink, int indent) const
     {
         ULXR_ASSERT_RPCTYPE(RpcStrType);
-        std::string s = getXmlIndent(indent);
-        s += "<value><string>";
-        s += xmlEscape(val);
-        s += "</string></value>";
-        return s;
+        sink.appendIndent(indent);
+        sink.append("<value><string>");
+        sink.appendEscaped(val);
+        sink.append("</string></value>");
+    }
+
+
+    std::size_t RpcString::getXmlSize(const XmlWriterOptions &options, int indent) const
+    {
+        ULXR_ASSERT_RPCTYPE(RpcStrType);
+        return options.getIndentSize(indent)
+             + sizeof("<value><string></string></value>") - 1
+             + xmlEscapedSize(val, options.getEscaping());
     }
 
 
     std::string RpcString::getString () const
     {
         ULXR_ASSERT_RPCTYPE(RpcStrType);
-        return val;
+        return std::string(val);
     }
 
 
@@ -869,333 +1342,1430 @@ namespace ulxr {
 
     Base64::Base64 ()
         : ValueBase(RpcBase64)
+        , forms(HasEncoded | HasDecoded)
     {
     }
 
 
     Base64::Base64 (const std::string &s)
         : ValueBase(RpcBase64)
+        , decoded(s)
+        , forms(HasDecoded)
     {
-        setString(s);
     }
 
 
-    Base64::~Base64 ()
+    Base64::Base64 (std::pmr::memory_resource *resource, const std::string &s)
+        : ValueBase(RpcBase64)
+        , encoded(s, resource)
+        , forms(HasEncoded)
+    {
+    }
+
+
+    Base64::Base64 (const Base64 &other)
+        : ValueBase(other)
+        , forms(other.forms.load(std::memory_order_acquire))
+    {
+        if (forms & HasEncoded)
+            encoded = other.encoded;
+        if (forms & HasDecoded)
+            decoded = other.decoded;
+    }
+
+
+    Base64::Base64 (Base64 &&other)
+        : ValueBase(other)
+        , encoded(std::move(other.encoded), std::pmr::get_default_resource())
+        , decoded(std::move(other.decoded), std::pmr::get_default_resource())
+        , forms(other.forms.load(std::memory_order_relaxed))
+    {
+        other.encoded.clear();
+        other.decoded.clear();
+        other.forms = HasEncoded | HasDecoded;
+    }
+
+
+    Base64::~Base64 ()
+    {
+    }
+
+
+    Base64 &Base64::operator= (const Base64 &other)
+    {
+        if (this != &other)
+        {
+            const unsigned char other_forms = other.forms.load(std::memory_order_acquire);
+            encoded.clear();
+            decoded.clear();
+            if (other_forms & HasEncoded)
+                encoded = other.encoded;
+            if (other_forms & HasDecoded)
+                decoded = other.decoded;
+            forms = other_forms;
+        }
+        return *this;
+    }
+
+
+    Base64 &Base64::operator= (Base64 &&other)
+    {
+        encoded = std::move(other.encoded);
+        decoded = std::move(other.decoded);
+        forms = other.forms.load(std::memory_order_relaxed);
+        other.encoded.clear();
+        other.decoded.clear();
+        other.forms = HasEncoded | HasDecoded;
+        return *this;
+    }
+
+
+    namespace
+    {
+
+        std::mutex base64Mutex;  // serializes the lazy conversions of all Base64 values
+
+    }
+
+
+    const std::pmr::string &Base64::getEncoded() const
+    {
+        if (!(forms.load(std::memory_order_acquire) & HasEncoded))
+        {
+            std::lock_guard<std::mutex> lock(base64Mutex);
+            if (!(forms.load(std::memory_order_relaxed) & HasEncoded))
+            {
+                encoded.resize(base64EncodedSize(decoded.size(), false));
+                base64Encode(reinterpret_cast<const unsigned char*>(decoded.data()), decoded.size(),
+                             false, &encoded[0]);
+                forms.fetch_or(HasEncoded, std::memory_order_release);
+            }
+        }
+        return encoded;
+    }
+
+
+    const std::pmr::string &Base64::getDecoded() const
+    {
+        if (!(forms.load(std::memory_order_acquire) & HasDecoded))
+        {
+            std::lock_guard<std::mutex> lock(base64Mutex);
+            if (!(forms.load(std::memory_order_relaxed) & HasDecoded))
+            {
+                std::size_t len = 0;
+                decoded.resize(base64DecodedMaxSize(encoded.size()));
+                if (!base64Decode(encoded.data(), encoded.size(), false,
+                                  reinterpret_cast<unsigned char*>(&decoded[0]), len))
+                    len = 0;
+                decoded.resize(len);
+                forms.fetch_or(HasDecoded, std::memory_order_release);
+            }
+        }
+        return decoded;
+    }
+
+
+    std::string Base64::getBase64() const
+    {
+        return std::string(getEncoded());
+    }
+
+
+    void Base64::setBase64(const std::string s)
+    {
+        encoded = s;
+        decoded.clear();
+        forms = HasEncoded;
+    }
+
+
+    ValueBase * Base64::cloneValue() const
+    {
+        ULXR_ASSERT_RPCTYPE(RpcBase64);
+        return new Base64(*this);
+    }
+
+
+    std::string Base64::getSignature(bool /*deep*/) const
+    {
+        ULXR_ASSERT_RPCTYPE(RpcBase64);
+        return getValueName();
+    }
+
+
+    std::string Base64::getValueName()
+    {
+        return "base64";
+    }
+
+
+    void Base64::serialize(XmlSink &sink, int indent) const
+    {
+        ULXR_ASSERT_RPCTYPE(RpcBase64);
+        sink.appendIndent(indent);
+        sink.append("<value><base64>");
+        sink.append(getEncoded());
+        sink.append("</base64></value>");
+    }
+
+
+    std::size_t Base64::getXmlSize(const XmlWriterOptions &options, int indent) const
+    {
+        ULXR_ASSERT_RPCTYPE(RpcBase64);
+        std::size_t size = options.getIndentSize(indent) + sizeof("<value><base64></base64></value>") - 1;
+        if (forms.load(std::memory_order_acquire) & HasEncoded)
+            return size + encoded.length();
+
+        return size + base64EncodedSize(decoded.length(), false);  // never converts the content
+    }
+
+
+    std::string Base64::getString () const
+    {
+        ULXR_ASSERT_RPCTYPE(RpcBase64);
+        return std::string(getDecoded());
+    }
+
+
+    void Base64::setString(const std::string &newval)
+    {
+        ULXR_ASSERT_RPCTYPE(RpcBase64);
+        decoded = newval;
+        encoded.clear();
+        forms = HasDecoded;
+    }
+
+
+//////////////////////////////////////////////////////
+
+
+    RawXml::RawXml (const std::string &s)
+        : ValueBase(RpcRawXml)
+        , xml(stripWS(s))
+    {
+        // a declaration or doctype in front would break the surrounding document
+        if (xml.compare(0, 6, "<value") != 0)
+            throw ParameterException(ApplicationError, "RawXml: no valid value: expected <value> element");
+
+        ValueParser parser;
+        bool ok = false;
+        try
+        {
+            ok = parser.parse(xml.data(), xml.length(), true);
+        }
+        catch (const XmlException &ex)
+        {
+            throw ParameterException(ApplicationError, "RawXml: no valid value: " + ex.why());
+        }
+
+        if (!ok)
+            throw ParameterException(ApplicationError,
+                                     "RawXml: no valid value: "
+                                     + parser.getErrorString(parser.getErrorCode()));
+
+        const Value val = parser.getValue();
+        signature = val.getSignature(false);
+        deepSignature = val.getSignature(true);
+    }
+
+
+    RawXml::RawXml (const char *s)
+        : RawXml(std::string(s))
+    {
+    }
+
+
+    RawXml::RawXml (const Value &val)
+        : ValueBase(RpcRawXml)
+        , xml(val.getXml(XmlWriterOptions().withPrettyPrint(false)))
+        , signature(val.getSignature(false))
+        , deepSignature(val.getSignature(true))
+    {
+    }
+
+
+    RawXml::RawXml (const Value &val, const XmlWriterOptions &options)
+        : ValueBase(RpcRawXml)
+        , xml(val.getXml(options))
+        , signature(val.getSignature(false))
+        , deepSignature(val.getSignature(true))
+    {
+    }
+
+
+    RawXml::RawXml (const RawXml &other)
+        : ValueBase(other)
+        , xml(other.xml)
+        , signature(other.signature)
+        , deepSignature(other.deepSignature)
+    {
+    }
+
+
+    RawXml::RawXml (RawXml &&other)
+        : ValueBase(other)
+        , xml(std::move(other.xml))
+        , signature(std::move(other.signature))
+        , deepSignature(std::move(other.deepSignature))
+    {
+    }
+
+
+    RawXml::~RawXml ()
+    {
+    }
+
+
+    const std::string &RawXml::getFragment() const
+    {
+        ULXR_ASSERT_RPCTYPE(RpcRawXml);
+        return xml;
+    }
+
+
+    ValueBase * RawXml::cloneValue() const
+    {
+        ULXR_ASSERT_RPCTYPE(RpcRawXml);
+        return new RawXml(*this);
+    }
+
+
+    std::string RawXml::getSignature(bool deep) const
+    {
+        ULXR_ASSERT_RPCTYPE(RpcRawXml);
+        return deep ? deepSignature : signature;
+    }
+
+
+    void RawXml::serialize(XmlSink &sink, int indent) const
+    {
+        ULXR_ASSERT_RPCTYPE(RpcRawXml);
+        sink.appendIndent(indent);
+        sink.append(xml);
+    }
+
+
+    std::size_t RawXml::getXmlSize(const XmlWriterOptions &options, int indent) const
+    {
+        ULXR_ASSERT_RPCTYPE(RpcRawXml);
+        return options.getIndentSize(indent) + xml.length();
+    }
+
+
+//////////////////////////////////////////////////////
+
+
+    namespace {
+
+        const std::int64_t secsPerDay = 86400;
+
+        // days since 1970-01-01 of a date in the proleptic gregorian calendar
+        std::int64_t daysFromCivil(std::int64_t y, unsigned m, unsigned d)
+        {
+            y -= m <= 2;
+            const std::int64_t era = (y >= 0 ? y : y - 399) / 400;
+            const unsigned yoe = static_cast<unsigned>(y - era * 400);
+            const unsigned doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+            const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+            return era * 146097 + doe - 719468;
+        }
+
+
+        void civilFromDays(std::int64_t z, std::int64_t &y, unsigned &m, unsigned &d)
+        {
+            z += 719468;
+            const std::int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+            const unsigned doe = static_cast<unsigned>(z - era * 146097);
+            const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+            const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+            const unsigned mp = (5 * doy + 2) / 153;
+            d = doy - (153 * mp + 2) / 5 + 1;
+            m = mp < 10 ? mp + 3 : mp - 9;
+            y = yoe + era * 400 + (m <= 2);
+        }
+
+
+        void splitStamp(std::int64_t stamp, tm &t)
+        {
+            std::int64_t days = stamp / secsPerDay;
+            std::int64_t secs = stamp % secsPerDay;
+            if (secs < 0)
+            {
+                secs += secsPerDay;
+                --days;
+            }
+
+            std::int64_t year;
+            unsigned month, day;
+            civilFromDays(days, year, month, day);
+            t = tm();
+            t.tm_year = static_cast<int>(year - 1900);
+            t.tm_mon = month - 1;
+            t.tm_mday = day;
+            t.tm_hour = static_cast<int>(secs / 3600);
+            t.tm_min = static_cast<int>(secs / 60 % 60);
+            t.tm_sec = static_cast<int>(secs % 60);
+        }
+
+
+        char *putDigits(char *p, unsigned num, unsigned width)
+        {
+            for (unsigned i = width; i > 0; --i, num /= 10)
+                p[i-1] = char('0' + num % 10);
+            return p + width;
+        }
+
+
+        bool getDigits(const char *&p, unsigned width, unsigned &num)
+        {
+            num = 0;
+            for (unsigned i = 0; i < width; ++i, ++p)
+            {
+                const unsigned digit = static_cast<unsigned char>(*p) - '0';
+                if (digit > 9)
+                    return false;
+                num = num * 10 + digit;
+            }
+            return true;
+        }
+
+
+        /* Parses one of 19980717T14:08:55, 1998-07-17T14:08:55,
+           19980717T140855 and 1998-07-17T140855. */
+        bool parseDateTime(const std::string &s, std::int64_t &stamp, bool &dash, bool &colon)
+        {
+            static const unsigned char monthDays[] = { 31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+
+            if (s.length() != 15 && s.length() != 17 && s.length() != 19)
+                return false;
+
+            const char *p = s.c_str();  // terminated, so no look ahead leaves the string
+            dash = p[4] == '-';
+            unsigned year, month, day, hour, min, sec;
+            if (   !getDigits(p, 4, year)
+                || (dash && *p++ != '-')
+                || !getDigits(p, 2, month)
+                || (dash && *p++ != '-')
+                || !getDigits(p, 2, day)
+                || *p++ != 'T'
+                || !getDigits(p, 2, hour))
+                return false;
+
+            colon = *p == ':';
+            if (   (colon && *p++ != ':')
+                || !getDigits(p, 2, min)
+                || (colon && *p++ != ':')
+                || !getDigits(p, 2, sec)
+                || p != s.c_str() + s.length())
+                return false;
+
+            const bool leap = year % 4 == 0 && (year % 100 != 0 || year % 400 == 0);
+            if (   month < 1 || month > 12
+                || day < 1 || day > monthDays[month-1]
+                || (month == 2 && day == 29 && !leap)
+                || hour > 23 || min > 59 || sec > 59)
+                return false;
+
+            stamp = daysFromCivil(year, month, day) * secsPerDay + hour * 3600 + min * 60 + sec;
+            return true;
+        }
+
+    }
+
+
+    DateTime::DateTime ()
+        : ValueBase(RpcDateTime)
+        , stamp(0)
+        , form(Verbatim)
+    {
+    }
+
+
+    DateTime::DateTime (const std::string &s)
+        : ValueBase(RpcDateTime)
+    {
+        setDateTime(s);
+    }
+
+
+    DateTime::DateTime (const time_t &tm)
+        : ValueBase(RpcDateTime)
+    {
+        setDateTime(tm);
+    }
+
+
+    DateTime::DateTime (std::pmr::memory_resource * /* resource */, const std::string &s)
+        : ValueBase(RpcDateTime)
+    {
+        setDateTime(s);
+    }
+
+
+    DateTime::~DateTime ()
+    {
+    }
+
+
+    ValueBase * DateTime::cloneValue() const
+    {
+        ULXR_ASSERT_RPCTYPE(RpcDateTime);
+        return new DateTime(*this);
+    }
+
+
+    std::string DateTime::getSignature(bool /*deep*/) const
+    {
+        ULXR_ASSERT_RPCTYPE(RpcDateTime);
+        return getValueName();
+    }
+
+
+    std::string DateTime::getValueName()
+    {
+        return "dateTime.iso8601";
+    }
+
+
+    void DateTime::serialize(XmlSink &sink, int indent) const
+    {
+        ULXR_ASSERT_RPCTYPE(RpcDateTime);
+        sink.appendIndent(indent);
+        sink.append("<value><dateTime.iso8601>");
+        if (form & Verbatim)
+            sink.append(text);
+        else
+        {
+            char buf[32];
+            sink.append(std::string_view(buf, format(buf) - buf));
+        }
+        sink.append("</dateTime.iso8601></value>");
+    }
+
+
+    std::size_t DateTime::getXmlSize(const XmlWriterOptions &options, int indent) const
+    {
+        ULXR_ASSERT_RPCTYPE(RpcDateTime);
+        std::size_t size = options.getIndentSize(indent)
+                         + sizeof("<value><dateTime.iso8601></dateTime.iso8601></value>") - 1;
+        if (form & Verbatim)
+            return size + text.length();
+
+        char buf[32];
+        return size + (format(buf) - buf);
+    }
+
+
+    std::string DateTime::getDateTime () const
+    {
+        ULXR_ASSERT_RPCTYPE(RpcDateTime);
+        if (form & Verbatim)
+            return text;
+
+        char buf[32];
+        return std::string(buf, format(buf));
+    }
+
+
+    char *DateTime::format(char *buf) const
+    {
+        tm t;
+        splitStamp(stamp, t);
+        const long year = t.tm_year + 1900L;
+
+        char *p = buf;
+        if (year >= 0 && year <= 9999)
+            p = putDigits(p, year, 4);
+        else
+        {
+            const std::string y = toString(year);
+            p = std::copy(y.begin(), y.end(), p);
+        }
+
+        if (form & WithDash)
+            *p++ = '-';
+        p = putDigits(p, t.tm_mon + 1, 2);
+        if (form & WithDash)
+            *p++ = '-';
+        p = putDigits(p, t.tm_mday, 2);
+        *p++ = 'T';
+        p = putDigits(p, t.tm_hour, 2);
+        if (form & WithColon)
+            *p++ = ':';
+        p = putDigits(p, t.tm_min, 2);
+        if (form & WithColon)
+            *p++ = ':';
+        return putDigits(p, t.tm_sec, 2);
+    }
+
+
+    void DateTime::setDateTime (const time_t &tmt,
+                                bool add_dash /* =false */,
+                                bool add_colon /* =true */)
+    {
+        ULXR_ASSERT_RPCTYPE(RpcDateTime);
+        tm ltm;
+        localtime_r(&tmt, &ltm);
+        stamp = daysFromCivil(ltm.tm_year + 1900LL, ltm.tm_mon + 1, ltm.tm_mday) * secsPerDay
+              + ltm.tm_hour * 3600 + ltm.tm_min * 60 + ltm.tm_sec;
+        form = (add_dash ? WithDash : 0) | (add_colon ? WithColon : 0);
+        text.clear();
+    }
+
+
+    void DateTime::setDateTime(const std::string &newval)
+    {
+        ULXR_ASSERT_RPCTYPE(RpcDateTime);
+        bool dash, colon;
+        if (parseDateTime(newval, stamp, dash, colon))
+        {
+            form = (dash ? WithDash : 0) | (colon ? WithColon : 0);
+            text.clear();
+        }
+        else
+        {
+            stamp = 0;
+            form = Verbatim;
+            text = newval;
+        }
+    }
+
+
+    std::time_t DateTime::getTimeT() const
+    {
+        ULXR_ASSERT_RPCTYPE(RpcDateTime);
+        if (form & Verbatim)
+            throw ParameterException(ApplicationError,
+                                     "DateTime::getTimeT(): no valid date: " + text);
+
+        tm t;
+        splitStamp(stamp, t);
+        t.tm_isdst = -1;
+        return std::mktime(&t);
+    }
+
+
+    bool DateTime::isValid() const
+    {
+        ULXR_ASSERT_RPCTYPE(RpcDateTime);
+        return !(form & Verbatim);
+    }
+
+
+//////////////////////////////////////////////////////
+
+
+    Array::Array ()
+        : ValueBase(RpcArray)
+        , storage(NoItems)
+    {
+    }
+
+
+    Array::Array (const std::vector<int> &items)
+        : ValueBase(RpcArray)
+        , storage(items.empty() ? NoItems : IntItems)
+        , ints(items.begin(), items.end())
+    {
+    }
+
+
+    Array::Array (const std::vector<double> &items)
+        : ValueBase(RpcArray)
+        , storage(items.empty() ? NoItems : DoubleItems)
+        , doubles(items.begin(), items.end())
+    {
+    }
+
+
+    Array::Array (const std::vector<bool> &items)
+        : ValueBase(RpcArray)
+        , storage(items.empty() ? NoItems : BoolItems)
+        , ints(items.begin(), items.end())
+    {
+    }
+
+
+    Array::Array (std::pmr::memory_resource *resource)
+        : ValueBase(RpcArray)
+        , storage(NoItems)
+        , values(resource)
+        , ints(resource)
+        , doubles(resource)
+    {
+    }
+
+
+    Array::Array (const Array &other)
+        : ValueBase(other)
+        , storage(other.storage)
+        , values(other.values)
+        , ints(other.ints)
+        , doubles(other.doubles)
+    {
+    }
+
+
+    Array::Array (Array &&other)
+        : ValueBase(other)
+        , storage(other.storage)
+        , values(std::move(other.values), std::pmr::get_default_resource())
+        , ints(std::move(other.ints), std::pmr::get_default_resource())
+        , doubles(std::move(other.doubles), std::pmr::get_default_resource())
+    {
+        other.clear();
+    }
+
+
+    Array::~Array ()
+    {
+    }
+
+
+    Array &Array::operator= (const Array &other)
+    {
+        storage = other.storage;
+        values = other.values;
+        ints = other.ints;
+        doubles = other.doubles;
+        return *this;
+    }
+
+
+    Array &Array::operator= (Array &&other)
+    {
+        storage = other.storage;
+        values = std::move(other.values);
+        ints = std::move(other.ints);
+        doubles = std::move(other.doubles);
+        other.clear();
+        return *this;
+    }
+
+
+    unsigned Array::size() const
+    {
+        switch (storage)
+        {
+        case IntItems:
+        case BoolItems:
+            return ints.size();
+
+        case DoubleItems:
+            return doubles.size();
+
+        default:
+            return values.size();
+        }
+    }
+
+
+    void Array::clear()
+    {
+        storage = NoItems;
+        values.clear();
+        ints.clear();
+        doubles.clear();
+    }
+
+
+    ValueBase * Array::cloneValue() const
+    {
+        ULXR_ASSERT_RPCTYPE(RpcArray);
+        return new Array(*this);
+    }
+
+
+    std::string Array::getSignature(bool deep) const
+    {
+        if (!deep)
+            return getValueName();
+
+
+        ULXR_ASSERT_RPCTYPE(RpcArray);
+        std::string s;
+        const unsigned num = size();
+        if (num == 0)
+            return "[]";
+
+        std::string item;
+        switch (storage)
+        {
+        case IntItems:
+            item = Integer::getValueName();
+            break;
+
+        case DoubleItems:
+            item = Double::getValueName();
+            break;
+
+        case BoolItems:
+            item = Boolean::getValueName();
+            break;
+
+        default:
+            break;
+        }
+
+        s += '[';
+        for (unsigned i = 0; i < num; ++i)
+        {
+            if (i != 0)
+                s += ',';
+            if (storage == ValueItems)
+                s += values[i].getSignature();
+            else
+                s += item;
+        }
+        s += ']';
+
+        return s;
+    }
+
+
+    std::string Array::getValueName()
+    {
+        return "array";
+    }
+
+
+    void Array::serialize(XmlSink &sink, int indent) const
+    {
+        ULXR_ASSERT_RPCTYPE(RpcArray);
+        sink.appendIndent(indent);
+        sink.append("<value>");
+        sink.appendLinefeed();
+        sink.appendIndent(indent+1);
+        sink.append("<array>");
+        sink.appendLinefeed();
+        sink.appendIndent(indent+2);
+        sink.append("<data>");
+        sink.appendLinefeed();
+
+        switch (storage)
+        {
+        case IntItems:
+            for (std::pmr::vector<int>::const_iterator
+                    it = ints.begin(); it != ints.end(); ++it)
+            {
+                sink.appendIndent(indent+3);
+                serializeInteger(sink, *it);
+                sink.appendLinefeed();
+            }
+            break;
+
+        case DoubleItems:
+            for (std::pmr::vector<double>::const_iterator
+                    it = doubles.begin(); it != doubles.end(); ++it)
+            {
+                sink.appendIndent(indent+3);
+                serializeDouble(sink, *it, sink.getOptions().getDoubleFormat());
+                sink.appendLinefeed();
+            }
+            break;
+
+        case BoolItems:
+            for (std::pmr::vector<int>::const_iterator
+                    it = ints.begin(); it != ints.end(); ++it)
+            {
+                sink.appendIndent(indent+3);
+                serializeBoolean(sink, *it != 0);
+                sink.appendLinefeed();
+            }
+            break;
+
+        default:
+            for (std::pmr::vector<Value>::const_iterator
+                    it = values.begin(); it != values.end(); ++it)
+            {
+                (*it).serialize(sink, indent+3);
+                sink.appendLinefeed();
+            }
+            break;
+        }
+
+        sink.appendIndent(indent+2);
+        sink.append("</data>");
+        sink.appendLinefeed();
+        sink.appendIndent(indent+1);
+        sink.append("</array>");
+        sink.appendLinefeed();
+        sink.appendIndent(indent);
+        sink.append("</value>");
+    }
+
+
+    std::size_t Array::getXmlSize(const XmlWriterOptions &options, int indent) const
+    {
+        ULXR_ASSERT_RPCTYPE(RpcArray);
+        const std::size_t lf = options.getLinefeedSize();
+        const std::size_t ind3 = options.getIndentSize(indent+3);
+        std::size_t size = options.getIndentSize(indent) * 2 + options.getIndentSize(indent+1) * 2
+                         + options.getIndentSize(indent+2) * 2 + lf * 5
+                         + sizeof("<value><array><data></data></array></value>") - 1;
+
+        switch (storage)
+        {
+        case IntItems:
+            for (std::pmr::vector<int>::const_iterator
+                    it = ints.begin(); it != ints.end(); ++it)
+                size += ind3 + getIntegerXmlSize(*it) + lf;
+            break;
+
+        case DoubleItems:
+            for (std::pmr::vector<double>::const_iterator
+                    it = doubles.begin(); it != doubles.end(); ++it)
+                size += ind3 + getDoubleXmlSize(*it, options.getDoubleFormat()) + lf;
+            break;
+
+        case BoolItems:
+            size += ints.size() * (ind3 + booleanXmlSize + lf);
+            break;
+
+        default:
+            for (std::pmr::vector<Value>::const_iterator
+                    it = values.begin(); it != values.end(); ++it)
+                size += (*it).getXmlSize(options, indent+3) + lf;
+            break;
+        }
+
+        return size;
+    }
+
+
+    template <class V>
+    void Array::appendItem(V &&item)
+    {
+        if (storage == NoItems)
+        {
+            if (item.isInteger())
+                storage = IntItems;
+            else if (item.isDouble())
+                storage = DoubleItems;
+            else if (item.isBoolean())
+                storage = BoolItems;
+            else
+                storage = ValueItems;
+        }
+
+        if (storage == IntItems && item.isInteger())
+            ints.push_back(static_cast<const Integer&>(item).getInteger());
+
+        else if (storage == DoubleItems && item.isDouble())
+            doubles.push_back(static_cast<const Double&>(item).getDouble());
+
+        else if (storage == BoolItems && item.isBoolean())
+            ints.push_back(static_cast<const Boolean&>(item).getBoolean());
+
+        else
+        {
+            unpack();
+            values.push_back(std::forward<V>(item));
+        }
+    }
+
+
+    void Array::unpack()
+    {
+        if (storage == ValueItems)
+            return;
+
+        values.reserve(size());
+        if (storage == IntItems)
+            for (unsigned i = 0; i < ints.size(); ++i)
+                values.push_back(Value(Integer(ints[i])));
+
+        else if (storage == DoubleItems)
+            for (unsigned i = 0; i < doubles.size(); ++i)
+                values.push_back(Value(Double(doubles[i])));
+
+        else if (storage == BoolItems)
+            for (unsigned i = 0; i < ints.size(); ++i)
+                values.push_back(Value(Boolean(ints[i] != 0)));
+
+        storage = ValueItems;
+        ints.clear();
+        ints.shrink_to_fit();
+        doubles.clear();
+        doubles.shrink_to_fit();
+    }
+
+
+    void Array::addItem(const Value &item)
+    {
+        appendItem(item);
+    }
+
+
+    void Array::addItem(Value &&item)
+    {
+        appendItem(std::move(item));
+    }
+
+
+    void Array::setItem(unsigned idx, const Value &item)
+    {
+        if (idx >= size())
+            return;
+
+        if (storage == IntItems && item.isInteger())
+            ints[idx] = static_cast<const Integer&>(item).getInteger();
+
+        else if (storage == DoubleItems && item.isDouble())
+            doubles[idx] = static_cast<const Double&>(item).getDouble();
+
+        else if (storage == BoolItems && item.isBoolean())
+            ints[idx] = static_cast<const Boolean&>(item).getBoolean();
+
+        else
+        {
+            unpack();
+            values[idx] = item;
+        }
+    }
+
+
+    Value Array::getItem(unsigned idx) const
+    {
+        if (idx >= size())
+            throw Exception(ApplicationError, "Array index is out of range");
+
+        switch (storage)
+        {
+        case IntItems:
+            return Value(Integer(ints[idx]));
+
+        case DoubleItems:
+            return Value(Double(doubles[idx]));
+
+        case BoolItems:
+            return Value(Boolean(ints[idx] != 0));
+
+        default:
+            return values[idx];
+        }
+    }
+
+
+    std::vector<int> Array::getIntVector() const
+    {
+        if (storage == IntItems)
+            return std::vector<int>(ints.begin(), ints.end());
+
+        if (storage != ValueItems && storage != NoItems)
+            throw ParameterException(ApplicationError, "Array::getIntVector(): member is not an Integer");
+
+        std::vector<int> ret;
+        ret.reserve(values.size());
+        for (unsigned i = 0; i < values.size(); ++i)
+        {
+            if (!values[i].isInteger())
+                throw ParameterException(ApplicationError, "Array::getIntVector(): member is not an Integer");
+            ret.push_back(static_cast<const Integer&>(values[i]).getInteger());
+        }
+        return ret;
+    }
+
+
+    std::vector<double> Array::getDoubleVector() const
+    {
+        if (storage == DoubleItems)
+            return std::vector<double>(doubles.begin(), doubles.end());
+
+        if (storage != ValueItems && storage != NoItems)
+            throw ParameterException(ApplicationError, "Array::getDoubleVector(): member is not a Double");
+
+        std::vector<double> ret;
+        ret.reserve(values.size());
+        for (unsigned i = 0; i < values.size(); ++i)
+        {
+            if (!values[i].isDouble())
+                throw ParameterException(ApplicationError, "Array::getDoubleVector(): member is not a Double");
+            ret.push_back(static_cast<const Double&>(values[i]).getDouble());
+        }
+        return ret;
+    }
+
+
+    std::vector<bool> Array::getBoolVector() const
     {
-    }
+        if (storage == BoolItems)
+            return std::vector<bool>(ints.begin(), ints.end());
 
+        if (storage != ValueItems && storage != NoItems)
+            throw ParameterException(ApplicationError, "Array::getBoolVector(): member is not a Boolean");
 
-    std::string Base64::getBase64() const
-    {
-        return val;
+        std::vector<bool> ret;
+        ret.reserve(values.size());
+        for (unsigned i = 0; i < values.size(); ++i)
+        {
+            if (!values[i].isBoolean())
+                throw ParameterException(ApplicationError, "Array::getBoolVector(): member is not a Boolean");
+            ret.push_back(static_cast<const Boolean&>(values[i]).getBoolean());
+        }
+        return ret;
     }
 
 
-    void Base64::setBase64(const std::string s)
-    {
-        val = s;
-    }
+//////////////////////////////////////////////////////
 
 
-    ValueBase * Base64::cloneValue() const
+    Struct::Member::Member(const std::string &str_, const Value &t_)
+        : str(str_)
+        , t(t_)
     {
-        ULXR_ASSERT_RPCTYPE(RpcBase64);
-        return new Base64(*this);
     }
 
 
-    std::string Base64::getSignature(bool /*deep*/) const
+    const std::string & Struct::Member::getName() const
     {
-        ULXR_ASSERT_RPCTYPE(RpcBase64);
-        return getValueName();
+        return str;
     }
 
 
-    std::string Base64::getValueName()
+    const Value & Struct::Member::getValue() const
     {
-        return "base64";
+        return t;
     }
 
 
-    std::string Base64::getXml(int indent) const
-    {
-        ULXR_ASSERT_RPCTYPE(RpcBase64);
-        std::string s = getXmlIndent(indent);
-        s += "<value><base64>";
-        s += val;
-        s += "</base64></value>";
-        return s;
-    }
+//////////////////////////////////////////////////////
 
 
-    std::string Base64::getString () const
+    struct MemberName::Entry
     {
-        ULXR_ASSERT_RPCTYPE(RpcBase64);
-        return vec2Str(fromBase64(val));
-    }
+        std::string            name;
+        std::size_t            hash;
+        std::atomic<unsigned>  refs;
+    };
 
 
-    void Base64::setString(const std::string &newval)
-    {
-        ULXR_ASSERT_RPCTYPE(RpcBase64);
-        val = toBase64(str2Vec<unsigned char>(newval));
-    }
+    namespace {
 
+        struct NameHash
+        {
+            std::size_t operator() (const std::string *name) const
+            {
+                return std::hash<std::string>()(*name);
+            }
+        };
 
-//////////////////////////////////////////////////////
 
+        struct NameEqual
+        {
+            bool operator() (const std::string *lhs, const std::string *rhs) const
+            {
+                return *lhs == *rhs;
+            }
+        };
 
-    DateTime::DateTime ()
-        : ValueBase(RpcDateTime)
-    {
-    }
 
+        const std::string &emptyName()
+        {
+            static const std::string *theEmpty = new std::string;
+            return *theEmpty;
+        }
 
-    DateTime::DateTime (const std::string &s)
-        : ValueBase(RpcDateTime)
-        , val(s)
-    {
     }
 
 
-    DateTime::DateTime (const time_t &tm)
-        : ValueBase(RpcDateTime)
+    struct MemberName::Table
     {
-        setDateTime(tm);
-    }
+        // Names which are no longer referenced stay in the table, so the
+        // bounded vocabulary of an application is not interned again for
+        // every message. They are purged once too many have piled up.
+        enum { MaxUnusedNames = 4096 };
 
+        std::mutex lock;
+        std::unordered_map<const std::string*, Entry*, NameHash, NameEqual> names;  // keys point into the entries
+        std::atomic<long> unused;  // entries with a count of 0, approximately
 
-    DateTime::~DateTime ()
-    {
-    }
+        Table()
+            : unused(0)
+        {
+        }
+
+        static Table &get()
+        {
+            static Table *theTable = new Table;  // never destroyed, static Structs may outlive it
+            return *theTable;
+        }
+
+        Entry *intern(const std::string &name)
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            std::unordered_map<const std::string*, Entry*, NameHash, NameEqual>::iterator it = names.find(&name);
+            if (it != names.end())
+            {
+                if ((*it).second->refs.fetch_add(1, std::memory_order_relaxed) == 0)
+                    unused.fetch_sub(1, std::memory_order_relaxed);
+                return (*it).second;
+            }
+
+            if (unused.load(std::memory_order_relaxed) > MaxUnusedNames)
+                purge();
+
+            Entry *entry = new Entry;
+            entry->name = name;
+            entry->hash = std::hash<std::string>()(name);
+            entry->refs.store(1, std::memory_order_relaxed);
+            names.insert(std::make_pair(&entry->name, entry));
+            return entry;
+        }
 
+        // Only intern() raises a count of 0 again and only purge() destroys
+        // entries, both while holding the lock. So releasing a name never
+        // needs the lock.
+        void release(Entry *entry)
+        {
+            if (entry->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                unused.fetch_add(1, std::memory_order_relaxed);
+        }
 
-    ValueBase * DateTime::cloneValue() const
+        void purge()
+        {
+            std::unordered_map<const std::string*, Entry*, NameHash, NameEqual>::iterator it = names.begin();
+            while (it != names.end())
+            {
+                Entry *entry = (*it).second;
+                if (entry->refs.load(std::memory_order_acquire) == 0)
+                {
+                    it = names.erase(it);
+                    delete entry;
+                }
+                else
+                    ++it;
+            }
+            unused.store(0, std::memory_order_relaxed);
+        }
+    };
+
+
+    MemberName::MemberName ()
+        : entry(0)
     {
-        ULXR_ASSERT_RPCTYPE(RpcDateTime);
-        return new DateTime(*this);
     }
 
 
-    std::string DateTime::getSignature(bool /*deep*/) const
+    MemberName::MemberName (const std::string &name)
+        : entry(0)
     {
-        ULXR_ASSERT_RPCTYPE(RpcDateTime);
-        return getValueName();
+        if (name.length() != 0)
+            entry = Table::get().intern(name);
     }
 
 
-    std::string DateTime::getValueName()
+    MemberName::MemberName (const MemberName &other)
+        : entry(other.entry)
     {
-        return "dateTime.iso8601";
+        if (entry != 0)
+            entry->refs.fetch_add(1, std::memory_order_relaxed);
     }
 
 
-    std::string DateTime::getXml(int indent) const
+    MemberName::MemberName (MemberName &&other) noexcept
+        : entry(other.entry)
     {
-        ULXR_ASSERT_RPCTYPE(RpcDateTime);
-        std::string s = getXmlIndent(indent);
-        s += "<value><dateTime.iso8601>";
-        s += val;
-        s += "</dateTime.iso8601></value>";
-        return s;
+        other.entry = 0;
     }
 
 
-    std::string DateTime::getDateTime () const
+    MemberName::~MemberName ()
     {
-        ULXR_ASSERT_RPCTYPE(RpcDateTime);
-        return val;
+        if (entry != 0)
+            Table::get().release(entry);
     }
 
 
-    namespace {
-
-        static std::string padded(unsigned num)
+    MemberName &MemberName::operator= (const MemberName &other)
+    {
+        if (entry != other.entry)
         {
-            std::string s;
-            if (num < 10)
-                s += L'0';
-            s += toString(num);
-            return s;
+            if (other.entry != 0)
+                other.entry->refs.fetch_add(1, std::memory_order_relaxed);
+            if (entry != 0)
+                Table::get().release(entry);
+            entry = other.entry;
         }
-
+        return *this;
     }
 
 
-    void DateTime::setDateTime (const time_t &tmt,
-                                bool add_dash /* =false */,
-                                bool add_colon /* =true */)
+    MemberName &MemberName::operator= (MemberName &&other) noexcept
     {
-        std::string s;
-        tm ltm;
-        localtime_r(&tmt, &ltm);
-        s += padded(ltm.tm_year+1900);
-        if (add_dash)
-            s += '-';
-        s += padded(ltm.tm_mon+1);
-        if (add_dash)
-            s += '-';
-        s += padded(ltm.tm_mday);
-        s += "T";
-        s += padded(ltm.tm_hour);
-        if (add_colon)
-            s += ':';
-        s += padded(ltm.tm_min);
-        if (add_colon)
-            s += ':';
-        s += padded(ltm.tm_sec);
-        setDateTime(s);
+        if (this != &other)
+        {
+            if (entry != 0)
+                Table::get().release(entry);
+            entry = other.entry;
+            other.entry = 0;
+        }
+        return *this;
     }
 
 
-    void DateTime::setDateTime(const std::string &newval)
+    const std::string &MemberName::str() const
     {
-        ULXR_ASSERT_RPCTYPE(RpcDateTime);
-        val = newval;
+        if (entry != 0)
+            return entry->name;
+        return emptyName();
     }
 
 
-//////////////////////////////////////////////////////
-
-
-    Array::Array ()
-        : ValueBase(RpcArray)
+    MemberName::operator const std::string& () const
     {
+        return str();
     }
 
 
-    Array::~Array ()
+    bool MemberName::empty() const
     {
+        return entry == 0;
     }
 
 
-    unsigned Array::size() const
+    std::size_t MemberName::hash() const
     {
-        return values.size();
+        if (entry != 0)
+            return entry->hash;
+        return std::hash<std::string>()(emptyName());
     }
 
 
-    void Array::clear()
+    bool MemberName::operator== (const MemberName &other) const
     {
-        values.clear();
+        return entry == other.entry;
     }
 
 
-    ValueBase * Array::cloneValue() const
+    bool MemberName::operator!= (const MemberName &other) const
     {
-        ULXR_ASSERT_RPCTYPE(RpcArray);
-        return new Array(*this);
+        return entry != other.entry;
     }
 
 
-    std::string Array::getSignature(bool deep) const
-    {
-        if (!deep)
-            return getValueName();
+//////////////////////////////////////////////////////
 
 
-        ULXR_ASSERT_RPCTYPE(RpcArray);
-        std::string s;
-        if (values.size() == 0)
-            return "[]";
+    namespace {
 
-        s += '[';
-        bool comma = values.size() >= 1;
-        for (unsigned i = 0; i < values.size(); ++i)
+        // up to this size a linear search is faster than binary search or hashing
+        // as most names already differ in their length
+        const unsigned LinearSearchLimit = 32;
+
+        struct LessMemberName
         {
-            if (comma && i != 0)
-                s += ',';
-            s += values[i].getSignature();
+            bool operator() (const std::pair<MemberName, Value> &lhs, const std::pair<MemberName, Value> &rhs) const
+            {
+                return lhs.first.str().compare(rhs.first.str()) < 0;
+            }
+        };
+
+
+        std::mutex structMutex;  // serializes the lazy sorting of all Structs
+
+
+        bool sameName(const MemberName &lhs, const std::string &rhs)
+        {
+            return lhs.str() == rhs;
         }
-        s += ']';
 
-        return s;
-    }
 
+        bool sameName(const MemberName &lhs, const MemberName &rhs)
+        {
+            return lhs == rhs;
+        }
 
-    std::string Array::getValueName()
-    {
-        return "array";
-    }
 
+        std::size_t nameHash(const std::string &name)
+        {
+            return std::hash<std::string>()(name);
+        }
 
-    std::string Array::getXml(int indent) const
-    {
-        ULXR_ASSERT_RPCTYPE(RpcArray);
-        std::string ind = getXmlIndent(indent);
-        std::string ind1 = getXmlIndent(indent+1);
-        std::string ind2 = getXmlIndent(indent+2);
-        std::string s = ind + "<value>" + getXmlLinefeed();
-        s += ind1 + "<array>" + getXmlLinefeed();
-        s += ind2 + "<data>" + getXmlLinefeed();
 
-        for (std::vector<Value>::const_iterator
-                it = values.begin(); it != values.end(); ++it)
+        std::size_t nameHash(const MemberName &name)
         {
-            s += (*it).getXml(indent+3) + getXmlLinefeed();
+            return name.hash();
         }
 
-        s += ind2 + "</data>" + getXmlLinefeed();
-        s += ind1 + "</array>"+ getXmlLinefeed();
-        s += ind + "</value>";
-        return s;
     }
 
 
-    void Array::addItem(const Value &item)
+    Struct::Struct ()
+        : ValueBase(RpcStruct)
+        , order(SortedByName)
+        , sorted(true)
     {
-        values.push_back(item);
     }
 
 
-    void Array::setItem(unsigned idx, const Value &item)
+    Struct::Struct (MemberOrder in_order)
+        : ValueBase(RpcStruct)
+        , order(in_order)
+        , sorted(true)
     {
-        if (idx < values.size() )
-            values[idx] = item;
     }
 
 
-    Value Array::getItem(unsigned idx) const
+    Struct::Struct (std::pmr::memory_resource *resource)
+        : ValueBase(RpcStruct)
+        , val(resource)
+        , slots(resource)
+        , order(SortedByName)
+        , sorted(true)
     {
-        if (idx < values.size() )
-            return values[idx];
-        throw Exception(ApplicationError, "Array index is out of range");
     }
 
 
-//////////////////////////////////////////////////////
-
-
-    Struct::Member::Member(const std::string &str_, const Value &t_)
-        : str(str_)
-        , t(t_)
+    Struct::Struct (const Struct &other)
+        : ValueBase(other)
+        , val(other.getAllMembers())
+        , slots(other.slots)
+        , order(other.order)
+        , sorted(true)
     {
     }
 
 
-    const std::string & Struct::Member::getName() const
+    Struct::Struct (Struct &&other)
+        : ValueBase(other)
+        , val(std::move(other.val), std::pmr::get_default_resource())
+        , slots(std::move(other.slots), std::pmr::get_default_resource())
+        , order(other.order)
+        , sorted(other.sorted.load(std::memory_order_relaxed))
     {
-        return str;
+        other.val.clear();
+        other.slots.clear();
+        other.sorted = true;
     }
 
 
-    const Value & Struct::Member::getValue() const
+    Struct::~Struct ()
     {
-        return t;
     }
 
 
-//////////////////////////////////////////////////////
-
-
-    Struct::Struct ()
-        : ValueBase(RpcStruct)
+    Struct &Struct::operator= (const Struct &other)
     {
+        other.ensureSorted();
+        val = other.val;
+        slots = other.slots;
+        order = other.order;
+        sorted = true;
+        return *this;
     }
 
 
-    Struct::~Struct ()
+    Struct &Struct::operator= (Struct &&other)
     {
+        val = std::move(other.val);
+        slots = std::move(other.slots);
+        order = other.order;
+        sorted = other.sorted.load(std::memory_order_relaxed);
+        other.val.clear();
+        other.slots.clear();
+        other.sorted = true;
+        return *this;
     }
 
 
@@ -1209,6 +2779,14 @@ namespace ulxr {
     void Struct::clear()
     {
         val.clear();
+        slots.clear();
+        sorted = true;
+    }
+
+
+    Struct::MemberOrder Struct::getMemberOrder() const
+    {
+        return order;
     }
 
 
@@ -1220,6 +2798,7 @@ namespace ulxr {
 
     const Struct::Members& Struct::getAllMembers() const
     {
+        ensureSorted();
         return val;
     }
 
@@ -1230,6 +2809,7 @@ namespace ulxr {
             return getValueName();
 
         ULXR_ASSERT_RPCTYPE(RpcStruct);
+        ensureSorted();
         std::string s;
         if (val.size() == 0)
             return "{}";
@@ -1240,7 +2820,7 @@ namespace ulxr {
         for (Members::const_iterator it = val.begin(); it != val.end(); ++it)
         {
             s += '{';
-            s += (*it).first;
+            s += (*it).first.str();
             s += ',';
             s += (*it).second.getSignature();
             s += '}';
@@ -1259,61 +2839,224 @@ namespace ulxr {
     }
 
 
-    std::string Struct::getXml(int indent) const
+    void Struct::serialize(XmlSink &sink, int indent) const
     {
         ULXR_ASSERT_RPCTYPE(RpcStruct);
-        std::string ind = getXmlIndent(indent);
-        std::string ind1 = getXmlIndent(indent+1);
-        std::string ind2 = getXmlIndent(indent+2);
-        std::string ind3 = getXmlIndent(indent+3);
-        std::string s = ind + "<value>"+ getXmlLinefeed();
-        s += ind1 + "<struct>" + getXmlLinefeed();
+        ensureSorted();
+        sink.appendIndent(indent);
+        sink.append("<value>");
+        sink.appendLinefeed();
+        sink.appendIndent(indent+1);
+        sink.append("<struct>");
+        sink.appendLinefeed();
 
         for (Members::const_iterator it = val.begin(); it != val.end(); ++it)
         {
-            s += ind2 + "<member>" + getXmlLinefeed();
-            s += ind3 + "<name>" + (*it).first + "</name>" + getXmlLinefeed();
-            s += (*it).second.getXml(indent+3) + getXmlLinefeed();
-            s += ind2 + "</member>" + getXmlLinefeed();
+            sink.appendIndent(indent+2);
+            sink.append("<member>");
+            sink.appendLinefeed();
+            sink.appendIndent(indent+3);
+            sink.append("<name>");
+            sink.append((*it).first.str());
+            sink.append("</name>");
+            sink.appendLinefeed();
+            (*it).second.serialize(sink, indent+3);
+            sink.appendLinefeed();
+            sink.appendIndent(indent+2);
+            sink.append("</member>");
+            sink.appendLinefeed();
         }
 
-        s += ind1 + "</struct>" + getXmlLinefeed();
-        s += ind + "</value>";
-        return s;
+        sink.appendIndent(indent+1);
+        sink.append("</struct>");
+        sink.appendLinefeed();
+        sink.appendIndent(indent);
+        sink.append("</value>");
+    }
+
+
+    std::size_t Struct::getXmlSize(const XmlWriterOptions &options, int indent) const
+    {
+        ULXR_ASSERT_RPCTYPE(RpcStruct);
+        ensureSorted();
+        const std::size_t lf = options.getLinefeedSize();
+        const std::size_t member = options.getIndentSize(indent+2) * 2 + options.getIndentSize(indent+3)
+                                 + lf * 4 + sizeof("<member><name></name></member>") - 1;
+        std::size_t size = options.getIndentSize(indent) * 2 + options.getIndentSize(indent+1) * 2
+                         + lf * 3 + sizeof("<value><struct></struct></value>") - 1;
+
+        for (Members::const_iterator it = val.begin(); it != val.end(); ++it)
+            size += member + (*it).first.str().length() + (*it).second.getXmlSize(options, indent+3);
+
+        return size;
     }
 
 
     void Struct::addMember(const std::string &name, const Value &item)
     {
-        ULXR_TRACE("Struct::addMember(string, Value)");
+        addMember(MemberName(name), item);
+    }
+
+
+    void Struct::addMember(const std::string &name, Value &&item)
+    {
+        addMember(MemberName(name), std::move(item));
+    }
+
+
+    void Struct::addMember(const MemberName &name, const Value &item)
+    {
+        ULXR_TRACE("Struct::addMember(MemberName, Value)");
+        ULXR_ASSERT_RPCTYPE(RpcStruct);
+        appendMember(name, item);
+    }
+
+
+    void Struct::addMember(const MemberName &name, Value &&item)
+    {
+        ULXR_TRACE("Struct::addMember(MemberName, Value&&)");
+        ULXR_ASSERT_RPCTYPE(RpcStruct);
+        appendMember(name, std::move(item));
+    }
+
+
+    void Struct::reserve(unsigned num)
+    {
         ULXR_ASSERT_RPCTYPE(RpcStruct);
-        val.insert(Member_pair(name, item));
+        val.reserve(num);
+    }
+
+
+    template <class V>
+    void Struct::appendMember(const MemberName &name, V &&item)
+    {
+        // the first member with a name wins, so sorting later on keeps it
+        if (findMember(name) != val.size())
+            return;
+
+        // inserting at the sorted position would shift the tail for
+        // every member which arrives out of order
+        if (order == SortedByName && !val.empty() && name.str() < val.back().first.str())
+            sorted.store(false, std::memory_order_relaxed);
+
+        val.push_back(Member_pair(name, std::forward<V>(item)));
+        if (val.size() > LinearSearchLimit)
+        {
+            if (val.size() * 2 > slots.size())
+                rebuildIndex();
+            else
+                indexMember(val.size()-1);
+        }
+    }
+
+
+    void Struct::indexMember(unsigned pos) const
+    {
+        const std::size_t mask = slots.size() - 1;
+        std::size_t i = val[pos].first.hash() & mask;
+        while (slots[i] != 0)
+            i = (i + 1) & mask;
+        slots[i] = pos + 1;
+    }
+
+
+    void Struct::ensureSorted() const
+    {
+        if (!sorted.load(std::memory_order_acquire))
+        {
+            std::lock_guard<std::mutex> lock(structMutex);
+            if (!sorted.load(std::memory_order_relaxed))
+            {
+                // the names are unique, so the order is well defined
+                std::sort(val.begin(), val.end(), LessMemberName());
+                if (val.size() > LinearSearchLimit)
+                    rebuildIndex();
+                sorted.store(true, std::memory_order_release);
+            }
+        }
+    }
+
+
+    void Struct::rebuildIndex() const
+    {
+        std::size_t num = 64;
+        while (num < val.size() * 4)
+            num *= 2;
+
+        slots.assign(num, 0);
+        for (unsigned pos = 0; pos < val.size(); ++pos)
+            indexMember(pos);
+    }
+
+
+    template <class N>
+    unsigned Struct::findMember(const N &name) const
+    {
+        if (val.size() <= LinearSearchLimit)
+        {
+            for (unsigned pos = 0; pos < val.size(); ++pos)
+                if (sameName(val[pos].first, name))
+                    return pos;
+        }
+
+        else
+        {
+            const std::size_t mask = slots.size() - 1;
+            for (std::size_t i = nameHash(name) & mask; slots[i] != 0; i = (i + 1) & mask)
+                if (sameName(val[slots[i]-1].first, name))
+                    return slots[i]-1;
+        }
+
+        return val.size();
     }
 
 
     bool Struct::hasMember(const std::string &name) const
     {
         ULXR_ASSERT_RPCTYPE(RpcStruct);
-        return val.find(name) != val.end();
+        ensureSorted();
+        return findMember(name) != val.size();
+    }
+
+
+    bool Struct::hasMember(const MemberName &name) const
+    {
+        ULXR_ASSERT_RPCTYPE(RpcStruct);
+        ensureSorted();
+        return findMember(name) != val.size();
     }
 
 
     Value Struct::getMember(const std::string &name) const
     {
         ULXR_ASSERT_RPCTYPE(RpcStruct);
-        Members::const_iterator it = val.find(name);
-        if (it  == val.end())
+        ensureSorted();
+        unsigned pos = findMember(name);
+        if (pos == val.size())
             throw RuntimeException(ApplicationError, "Attempt to get unknown Struct member: " +name);
 
-        return (*it).second;
+        return val[pos].second;
+    }
+
+
+    Value Struct::getMember(const MemberName &name) const
+    {
+        ULXR_ASSERT_RPCTYPE(RpcStruct);
+        ensureSorted();
+        unsigned pos = findMember(name);
+        if (pos == val.size())
+            throw RuntimeException(ApplicationError, "Attempt to get unknown Struct member: " +name.str());
+
+        return val[pos].second;
     }
 
 
     std::vector<std::string> Struct::getMemberNames() const
     {
+        ensureSorted();
         std::vector<std::string> names;
         for (Members::const_iterator it = val.begin(); it != val.end(); ++it)
-            names.push_back((*it).first);
+            names.push_back((*it).first.str());
         return names;
     }
 
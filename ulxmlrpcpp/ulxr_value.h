@@ -32,10 +32,15 @@
 
 
 #include <ulxmlrpcpp/ulxmlrpcpp.h>
+#include <ulxmlrpcpp/ulxr_xmlsink.h>
 
 #include <map>
 #include <vector>
 #include <ctime>
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <memory_resource>
 
 
 namespace ulxr {
@@ -48,7 +53,8 @@ namespace ulxr {
     {
         RpcInteger, RpcDouble,   RpcBoolean,
         RpcStrType, RpcDateTime, RpcBase64,
-        RpcArray,   RpcStruct,   RpcVoid
+        RpcArray,   RpcStruct,   RpcVoid,
+        RpcRawXml
     }
     ValueType;
 
@@ -62,11 +68,24 @@ namespace ulxr {
     class RpcString;
     class Base64;
     class DateTime;
+    class RawXml;
     class ValueBase;
+    class ValueArena;
 
 
     /** Abstraction of an XML RPC parameter.
       * Parameters are passed to and returned by method calls.
+      *
+      * Copies of a Value share their content until one of them is modified
+      * (copy-on-write), so passing values around or returning them from
+      * Array::getItem() and Struct::getMember() is cheap even for large trees.
+      * As soon as a non-const reference to the content is handed out
+      * (e.g. via <code>operator Array&</code> or getStruct()), the content is no
+      * longer shared and further copies become real duplicates again.
+      *
+      * Scalars (Void, Boolean, Integer and Double) are stored inside the Value
+      * itself and need no heap allocation, so arrays of numbers are laid out
+      * contiguously.
       */
     class  Value
     {
@@ -81,6 +100,12 @@ namespace ulxr {
           */
         Value (const Value &val);
 
+        /** Creates a Value by taking over the content of another Value.
+          * The source Value is left as Void.
+          * @param  val  the source value
+          */
+        Value (Value &&val) noexcept;
+
         /** Creates a value from a Boolean
           * @param  val  the source value
           */
@@ -101,26 +126,56 @@ namespace ulxr {
           */
         Value (const Array &val);
 
+        /** Creates a value by taking over the content of a Array
+          * @param  val  the source value
+          */
+        Value (Array &&val);
+
         /** Creates a value from a Struct
           * @param  val  the source value
           */
         Value (const Struct &val);
 
+        /** Creates a value by taking over the content of a Struct
+          * @param  val  the source value
+          */
+        Value (Struct &&val);
+
         /** Creates a value from a RpcString
           * @param  val  the source value
           */
         Value (const RpcString &val);
 
+        /** Creates a value by taking over the content of a RpcString
+          * @param  val  the source value
+          */
+        Value (RpcString &&val);
+
         /** Creates a value from a Base64
           * @param  val  the source value
           */
         Value (const Base64 &val);
 
+        /** Creates a value by taking over the content of a Base64
+          * @param  val  the source value
+          */
+        Value (Base64 &&val);
+
         /** Creates a value from a DateTime
           * @param  val  the source value
           */
         Value (const DateTime &val);
 
+        /** Creates a value from a RawXml
+          * @param  val  the source value
+          */
+        Value (const RawXml &val);
+
+        /** Creates a value by taking over the content of a RawXml
+          * @param  val  the source value
+          */
+        Value (RawXml &&val);
+
         /** Creates a value from a const char*
           * @param  val  the source value
           */
@@ -156,6 +211,12 @@ namespace ulxr {
           */
         Value &operator=(const Value &val);
 
+        /** Takes over the content of another Value.
+          * The source Value is left as Void.
+          * @param  val  the source value
+          */
+        Value &operator=(Value &&val) noexcept;
+
         /** Returns the signature of value.
           * The signature consists of its type name.
           * @param deep  if nested types exist, include them
@@ -172,6 +233,34 @@ namespace ulxr {
           */
         std::string getXml(int indent = 0) const;
 
+        /** Returns the value as xml string.
+          * @param  options  settings for the generated xml
+          * @param  indent   current indentation level
+          * @return  The xml content
+          */
+        std::string getXml(const XmlWriterOptions &options, int indent = 0) const;
+
+        /** Writes the value as xml to a sink.
+          * The content and its type name is converted to an xml text.
+          * @param  sink     receives the xml content
+          * @param  indent   current indentation level
+          */
+        void serialize(XmlSink &sink, int indent = 0) const;
+
+        /** Returns the size of the xml which \c serialize() writes
+          * with the process wide settings.
+          * @param  indent   current indentation level
+          * @return  number of characters
+          */
+        std::size_t getXmlSize(int indent = 0) const;
+
+        /** Returns the size of the xml which \c serialize() writes.
+          * @param  options  settings for the generated xml
+          * @param  indent   current indentation level
+          * @return  number of characters
+          */
+        std::size_t getXmlSize(const XmlWriterOptions &options, int indent = 0) const;
+
         /** Converts the Value into a Void.
           * If the type does not match exactly a RuntimeException is thrown.
           * @return the converted Value.
@@ -279,6 +368,12 @@ namespace ulxr {
           */
         operator const DateTime& () const;
 
+        /** Converts the Value into a RawXml.
+          * If the type does not match exactly a RuntimeException is thrown.
+          * @return the converted Value.
+          */
+        operator const RawXml& () const;
+
         /** Converts the Value into a Struct.
           * If the type does not match exactly a RuntimeException is thrown.
           * @return a pointer to the converted Value.
@@ -348,6 +443,11 @@ namespace ulxr {
           */
         bool isDateTime() const;
 
+        /** Determines if the Value is of type RawXml.
+          * @return true if the type is correct.
+          */
+        bool isRawXml() const;
+
         /** Returns the type of the Value.
           * @return value type
           */
@@ -360,6 +460,62 @@ namespace ulxr {
 
     private:
 
+        friend class ValueParserBase;
+
+        /** Determines if the content is stored inside the Value.
+          * @return true for scalar types
+          */
+        bool isInline() const;
+
+        /** Copies scalar content into the inline storage.
+          * @param  node  the content to copy
+          */
+        void copyInline(const ValueBase *node);
+
+        /** Shares the content of another Value if possible or duplicates it.
+          * The current content must have been released before.
+          * @param  val  the source value
+          */
+        void acquire(const Value &val);
+
+        /** Takes over the content of another Value which becomes Void.
+          * The current content must have been released before.
+          * @param  val  the source value
+          */
+        void takeOver(Value &val);
+
+        /** Drops the reference to the content and destroys it if
+          * it was the last one.
+          */
+        void release();
+
+        /** Ensures the content is not shared with other Values
+          * by duplicating it if necessary.
+          */
+        void detach();
+
+        /** Prepares the content for the hand out of a non-const reference.
+          * The content is detached and never shared again.
+          */
+        void unshare();
+
+        /** Takes over a node which was created by the parser.
+          * @param  node  the new content, already referenced once
+          */
+        void adopt(ValueBase *node);
+
+        /** Returns the Struct for modification by the parser.
+          * No reference escapes, so the content remains shareable.
+          * @return pointer to the Struct
+          */
+        Struct* modifyStruct();
+
+        /** Returns the Array for modification by the parser.
+          * No reference escapes, so the content remains shareable.
+          * @return pointer to the Array
+          */
+        Array* modifyArray();
+
         union
         {
             ValueBase *baseVal;
@@ -373,6 +529,16 @@ namespace ulxr {
             RpcString *stringVal;
             Base64    *base64Val;
             DateTime  *dateVal;
+            RawXml    *rawVal;
+        };
+
+        enum { InlineSize = 24 };  // large enough for the scalar types
+
+        union
+        {
+            double        alignDouble;
+            void         *alignPointer;
+            unsigned char inlineData[InlineSize];
         };
     };
 
@@ -393,6 +559,17 @@ namespace ulxr {
           */
         ValueBase (ValueType t);
 
+        /** Creates a ValueBase as duplicate of another ValueBase.
+          * The duplicate is not shared by any Value.
+          * @param  other  the source value
+          */
+        ValueBase (const ValueBase &other);
+
+        /** Copies the content of another ValueBase.
+          * @param  other  the source value
+          */
+        ValueBase &operator= (const ValueBase &other);
+
         /** Destroys the ValueBase
           */
         virtual ~ValueBase ();
@@ -442,6 +619,11 @@ namespace ulxr {
           */
         bool isDateTime() const;
 
+        /** Determines if the Value is of type RawXml.
+          * @return true if the type is correct.
+          */
+        bool isRawXml() const;
+
         /** Returns the type of the Value.
           * @return value type
           */
@@ -466,7 +648,28 @@ namespace ulxr {
           * @param  indent   current indentation level
           * @return  The xml content
           */
-        virtual std::string getXml(int indent = 0) const = 0;
+        virtual std::string getXml(int indent = 0) const;
+
+        /** Returns the value as xml string.
+          * @param  options  settings for the generated xml
+          * @param  indent   current indentation level
+          * @return  The xml content
+          */
+        std::string getXml(const XmlWriterOptions &options, int indent = 0) const;
+
+        /** Writes the value as xml to a sink.
+          * The content and its type name is converted to an xml text.
+          * @param  sink     receives the xml content
+          * @param  indent   current indentation level
+          */
+        virtual void serialize(XmlSink &sink, int indent = 0) const = 0;
+
+        /** Returns the size of the xml which \c serialize() writes.
+          * @param  options  settings for the generated xml
+          * @param  indent   current indentation level
+          * @return  number of characters
+          */
+        virtual std::size_t getXmlSize(const XmlWriterOptions &options, int indent = 0) const = 0;
 
         /** Returns the C++-name of the ValueType.
           * @return type name
@@ -475,7 +678,13 @@ namespace ulxr {
 
     private:
 
-        ValueType type;
+        friend class Value;
+        friend class ValueArena;
+
+        std::atomic<int> refs;   // number of Values sharing this object
+        ValueType type : 8;
+        bool shareable;          // false after a non-const reference was handed out
+        bool inArena;            // allocated by a ValueArena, never modified
 
         /** Constructor for an empty ValueBase.
           * Exists as private method to prevent its use.
@@ -521,14 +730,19 @@ namespace ulxr {
           */
         static std::string getValueName();
 
-        /** Returns the value as xml string.
+        /** Writes the value as xml to a sink.
           * The content and its type name is converted to an xml text.
-          * The structure of the text is indented to facilitate easy reading
-          * of larger blocks.
+          * @param  sink     receives the xml content
           * @param  indent   current indentation level
-          * @return  The xml content
           */
-        virtual std::string getXml(int indent = 0) const;
+        virtual void serialize(XmlSink &sink, int indent = 0) const;
+
+        /** Returns the size of the xml which \c serialize() writes.
+          * @param  options  settings for the generated xml
+          * @param  indent   current indentation level
+          * @return  number of characters
+          */
+        virtual std::size_t getXmlSize(const XmlWriterOptions &options, int indent = 0) const;
 
     private:
 
@@ -593,14 +807,19 @@ namespace ulxr {
           */
         static std::string getValueName();
 
-        /** Returns the value as xml string.
-         * The content and its type name is converted to an xml text.
-         * The structure of the text is indented to facilitate easy reading
-         * of larger blocks.
-         * @param  indent   current indentation level
-         * @return  The xml content
-         */
-        virtual std::string getXml(int indent = 0) const;
+        /** Writes the value as xml to a sink.
+          * The content and its type name is converted to an xml text.
+          * @param  sink     receives the xml content
+          * @param  indent   current indentation level
+          */
+        virtual void serialize(XmlSink &sink, int indent = 0) const;
+
+        /** Returns the size of the xml which \c serialize() writes.
+          * @param  options  settings for the generated xml
+          * @param  indent   current indentation level
+          * @return  number of characters
+          */
+        virtual std::size_t getXmlSize(const XmlWriterOptions &options, int indent = 0) const;
 
     private:
 
@@ -630,9 +849,19 @@ namespace ulxr {
 
         /** Constructs an Integer.
           * @param  s  value for the construction as number string
+          * @throw ParameterException if \c s is no valid number, see \c parse()
           */
         Integer (const std::string &s);
 
+        /** Converts the text of an integer.
+          * Surrounding white space and a leading '+' are allowed. Other
+          * characters or values outside the range of int are rejected.
+          * @param  s   the text
+          * @param  i   returns the value
+          * @return false if \c s is no valid number
+          */
+        static bool parse(std::string_view s, int &i);
+
         /** Destroys the Value
           */
         virtual ~Integer ();
@@ -664,14 +893,19 @@ namespace ulxr {
           */
         static std::string getValueName();
 
-        /** Returns the value as xml string.
+        /** Writes the value as xml to a sink.
           * The content and its type name is converted to an xml text.
-          * The structure of the text is indented to facilitate easy reading
-          * of larger blocks.
+          * @param  sink     receives the xml content
           * @param  indent   current indentation level
-          * @return  The xml content
           */
-        virtual std::string getXml(int indent = 0) const;
+        virtual void serialize(XmlSink &sink, int indent = 0) const;
+
+        /** Returns the size of the xml which \c serialize() writes.
+          * @param  options  settings for the generated xml
+          * @param  indent   current indentation level
+          * @return  number of characters
+          */
+        virtual std::size_t getXmlSize(const XmlWriterOptions &options, int indent = 0) const;
 
     private:
 
@@ -703,9 +937,20 @@ namespace ulxr {
 
         /** Constructs a Double.
           * @param  s  value for the construction as number string
+          * @throw ParameterException if \c s is no valid number, see \c parse()
           */
         Double (const std::string &s);
 
+        /** Converts the text of a double.
+          * Surrounding white space and a leading '+' are allowed as well
+          * as an exponent. Other characters or values which are too large
+          * or too small for a double are rejected.
+          * @param  s   the text
+          * @param  d   returns the value
+          * @return false if \c s is no valid number
+          */
+        static bool parse(std::string_view s, double &d);
+
         /** Destroys the Value
           */
         virtual ~Double ();
@@ -737,14 +982,27 @@ namespace ulxr {
           */
         static std::string getValueName();
 
-        /** Returns the value as xml string.
+        /** Writes the value as xml to a sink.
           * The content and its type name is converted to an xml text.
-          * The structure of the text is indented to facilitate easy reading
-          * of larger blocks.
+          * @param  sink     receives the xml content
           * @param  indent   current indentation level
-          * @return  The xml content
           */
-        virtual std::string getXml(int indent = 0) const;
+        virtual void serialize(XmlSink &sink, int indent = 0) const;
+
+        /** Returns the size of the xml which \c serialize() writes.
+          * @param  options  settings for the generated xml
+          * @param  indent   current indentation level
+          * @return  number of characters
+          */
+        virtual std::size_t getXmlSize(const XmlWriterOptions &options, int indent = 0) const;
+
+        /** Conversion modes for double values.
+          */
+        typedef XmlWriterOptions::DoubleFormat Format;
+
+        static constexpr Format FixedFormat = XmlWriterOptions::FixedFormat;
+        static constexpr Format ScientificFormat = XmlWriterOptions::ScientificFormat;
+        static constexpr Format ShortestFormat = XmlWriterOptions::ShortestFormat;
 
         /** Switches the conversion mode for double values.
           * Large numbers create large strings for the number without necessarily increasing
@@ -753,16 +1011,38 @@ namespace ulxr {
           * @li A floating point value using only digits and a decimal point like
           *     1234567.890123. This is the default.
           * @li Scientific mode with mantissa and exponent like 123.4567E12.
+          *
+          * The mode is process-wide and applies to xml which is written
+          * without explicit \c XmlWriterOptions.
           * @param   scientific   true: use scientifiy mode like 123.456E-78
           * @return the previous setting
           */
         static bool setScientificMode(bool scientific);
 
+        /** Returns the conversion mode for double values.
+          * @return true: scientific mode
+          */
+        static bool getScientificMode();
+
+        /** Switches the conversion mode for double values.
+          * \c ShortestFormat writes digits and a decimal point only, like the
+          * default, but as many digits as needed to read back the exact value
+          * and not more. It does not depend on the locale and is the fastest mode.
+          * @param   format   the new mode
+          * @return the previous mode
+          */
+        static Format setFormat(Format format);
+
+        /** Returns the conversion mode for double values.
+          * @return the current mode
+          */
+        static Format getFormat();
+
     private:
 
         double val;
 
-        static bool scientific;
+        static std::atomic<Format> format;
     };
 
 
@@ -773,6 +1053,10 @@ namespace ulxr {
       * An Array can contain an arbitrary amount of values
       * of any type here mentioned, even nested arrays.
       * You access the elements by their index.
+      *
+      * As long as all elements are of type Integer, Double or Boolean
+      * they are kept packed as plain numbers. Adding an element of another
+      * type converts the Array into a collection of Values.
       * @ingroup grp_ulxr_value_type
       */
     class  Array : public ValueBase
@@ -783,15 +1067,55 @@ namespace ulxr {
           */
         Array ();
 
+        /** Constructs an Array of Integers.
+          * @param  items  the element values
+          */
+        explicit Array (const std::vector<int> &items);
+
+        /** Constructs an Array of Doubles.
+          * @param  items  the element values
+          */
+        explicit Array (const std::vector<double> &items);
+
+        /** Constructs an Array of Booleans.
+          * @param  items  the element values
+          */
+        explicit Array (const std::vector<bool> &items);
+
+        /** Creates an Array as duplicate of another Array.
+          * @param  other  the source array
+          */
+        Array (const Array &other);
+
+        /** Creates an Array by taking over the members of another Array.
+          * @param  other  the source array, empty afterwards
+          */
+        Array (Array &&other);
+
         /** Destroys the Value
           */
         virtual ~Array ();
 
+        /** Copies the members of another Array.
+          * @param  other  the source array
+          */
+        Array &operator= (const Array &other);
+
+        /** Takes over the members of another Array.
+          * @param  other  the source array, empty afterwards
+          */
+        Array &operator= (Array &&other);
+
         /** Appends a new array member.
           * @param  item    the new Value
           */
         void addItem(const Value &item);
 
+        /** Appends a new array member by taking over its content.
+          * @param  item    the new Value
+          */
+        void addItem(Value &&item);
+
         /** Sets a new content of an array member.
           * Counting starts with "0".
           * @param  idx     index of the desired Value
@@ -811,6 +1135,24 @@ namespace ulxr {
           */
         unsigned size() const;
 
+        /** Returns the content of all members.
+          * @return the values of the Integers
+          * @throw ParameterException if a member is not an Integer
+          */
+        std::vector<int> getIntVector() const;
+
+        /** Returns the content of all members.
+          * @return the values of the Doubles
+          * @throw ParameterException if a member is not a Double
+          */
+        std::vector<double> getDoubleVector() const;
+
+        /** Returns the content of all members.
+          * @return the values of the Booleans
+          * @throw ParameterException if a member is not a Boolean
+          */
+        std::vector<bool> getBoolVector() const;
+
         /** Creates a copy of the actual object.
           * @return pointer to the copy
           */
@@ -829,14 +1171,19 @@ namespace ulxr {
           */
         static std::string getValueName();
 
-        /** Returns the value as xml string.
+        /** Writes the value as xml to a sink.
           * The content and its type name is converted to an xml text.
-          * The structure of the text is indented to facilitate easy reading
-          * of larger blocks.
+          * @param  sink     receives the xml content
           * @param  indent   current indentation level
-          * @return  The xml content
           */
-        virtual std::string getXml(int indent = 0) const;
+        virtual void serialize(XmlSink &sink, int indent = 0) const;
+
+        /** Returns the size of the xml which \c serialize() writes.
+          * @param  options  settings for the generated xml
+          * @param  indent   current indentation level
+          * @return  number of characters
+          */
+        virtual std::size_t getXmlSize(const XmlWriterOptions &options, int indent = 0) const;
 
         /** Removes all elements of the Array.
           */
@@ -844,7 +1191,38 @@ namespace ulxr {
 
     private:
 
-        std::vector<Value> values;
+        friend class ValueArena;
+
+        /** Constructs an empty Array inside an arena.
+          * @param  resource  memory for the members
+          */
+        explicit Array (std::pmr::memory_resource *resource);
+
+        /** Appends a member, packed if possible.
+          * @param  item  the new Value
+          */
+        template <class V>
+        void appendItem(V &&item);
+
+        /** Converts packed members into Values.
+          */
+        void unpack();
+
+        /** Kind of storage of the members.
+          */
+        enum Storage
+        {
+            NoItems,        //!< empty, decided by the first member
+            IntItems,       //!< all members are Integers in ints
+            DoubleItems,    //!< all members are Doubles in doubles
+            BoolItems,      //!< all members are Booleans in ints
+            ValueItems      //!< arbitrary members in values
+        };
+
+        Storage                   storage;
+        std::pmr::vector<Value>   values;
+        std::pmr::vector<int>     ints;
+        std::pmr::vector<double>  doubles;
     };
 
 
@@ -857,6 +1235,96 @@ namespace ulxr {
         return array;
     }
 
+//////////////////////////////////////////////////////////////
+
+
+    /** Name of a Struct member.
+      * Names are interned in a process wide table. Equal names share one
+      * string which stays in the table after the last MemberName referring
+      * to it is gone, until a few thousand such names have piled up.
+      * Comparing two MemberNames compares pointers, and repeated names in
+      * large trees cost only a pointer each.
+      * @ingroup grp_ulxr_value_type
+      */
+    class  MemberName
+    {
+    public:
+
+        /** Creates an empty name.
+          */
+        MemberName ();
+
+        /** Creates a name by interning a string.
+          * @param  name  the name
+          */
+        explicit MemberName (const std::string &name);
+
+        /** Creates a MemberName referring to the same name as another one.
+          * @param  other  the source name
+          */
+        MemberName (const MemberName &other);
+
+        /** Creates a MemberName by taking over another one which becomes empty.
+          * @param  other  the source name
+          */
+        MemberName (MemberName &&other) noexcept;
+
+        /** Destroys the MemberName
+          */
+        ~MemberName ();
+
+        /** Refers to the same name as another MemberName.
+          * @param  other  the source name
+          */
+        MemberName &operator= (const MemberName &other);
+
+        /** Takes over another MemberName which becomes empty.
+          * @param  other  the source name
+          */
+        MemberName &operator= (MemberName &&other) noexcept;
+
+        /** Returns the name as string.
+          * @return the name
+          */
+        const std::string &str() const;
+
+        /** Returns the name as string.
+          * @return the name
+          */
+        operator const std::string& () const;
+
+        /** Tests if the name is empty.
+          * @return true if empty
+          */
+        bool empty() const;
+
+        /** Returns the hash value of the name.
+          * It equals std::hash<std::string> of str().
+          * @return the hash value
+          */
+        std::size_t hash() const;
+
+        /** Compares two names.
+          * @param  other  the name to compare with
+          * @return true if both names are equal
+          */
+        bool operator== (const MemberName &other) const;
+
+        /** Compares two names.
+          * @param  other  the name to compare with
+          * @return true if both names differ
+          */
+        bool operator!= (const MemberName &other) const;
+
+    private:
+
+        struct Entry;
+        struct Table;
+
+        Entry *entry;
+    };
+
+
 //////////////////////////////////////////////////////////////
 
 
@@ -865,6 +1333,12 @@ namespace ulxr {
       * of any type here mentioned, even nested Structs.
       * Unlike arrays you access their values by their member names
       * and not by their index.
+      *
+      * The members are kept in one contiguous vector, by default sorted by
+      * name. New members are always appended, a Struct whose members arrive
+      * out of order is sorted once when it is read the first time.
+      * Small Structs are searched linearly, larger ones via an open
+      * addressing hash index. Member names are interned, see MemberName.
       * @ingroup grp_ulxr_value_type
       */
     class  Struct : public ValueBase
@@ -873,20 +1347,78 @@ namespace ulxr {
 
         class Member;
 
+        /** Order of the members when iterating or serializing.
+          */
+        enum MemberOrder
+        {
+            SortedByName,    //!< members are sorted by their name (default)
+            InsertionOrder   //!< members keep the order they were added
+        };
+
         /** Default constructor for an empty Struct.
           */
         Struct ();
 
+        /** Constructs an empty Struct.
+          * @param  order  the order of the members
+          */
+        explicit Struct (MemberOrder order);
+
+        /** Creates a Struct as duplicate of another Struct.
+          * @param  other  the source struct
+          */
+        Struct (const Struct &other);
+
+        /** Creates a Struct by taking over the members of another Struct.
+          * @param  other  the source struct, empty afterwards
+          */
+        Struct (Struct &&other);
+
         /** Destroys the Value
           */
         virtual ~Struct ();
 
+        /** Copies the members of another Struct.
+          * @param  other  the source struct
+          */
+        Struct &operator= (const Struct &other);
+
+        /** Takes over the members of another Struct.
+          * @param  other  the source struct, empty afterwards
+          */
+        Struct &operator= (Struct &&other);
+
         /** Adds a name/Value pair.
+          * If a member with this name already exists it is left unchanged.
           * @param  name the name of the member
           * @param  item its content
           */
         void addMember(const std::string &name, const Value &item);
 
+        /** Adds a name/Value pair by taking over the content of the Value.
+          * @param  name the name of the member
+          * @param  item its content
+          */
+        void addMember(const std::string &name, Value &&item);
+
+        /** Adds a name/Value pair.
+          * If a member with this name already exists it is left unchanged.
+          * @param  name the name of the member
+          * @param  item its content
+          */
+        void addMember(const MemberName &name, const Value &item);
+
+        /** Adds a name/Value pair by taking over the content of the Value.
+          * @param  name the name of the member
+          * @param  item its content
+          */
+        void addMember(const MemberName &name, Value &&item);
+
+        /** Reserves room for members which are added later.
+          * @param  num  the expected number of members
+          */
+        void reserve(unsigned num);
+
         /** Gets a list of all member names.
           * @return vector with all member names
           */
@@ -898,12 +1430,26 @@ namespace ulxr {
           */
         Value getMember(const std::string &name) const;
 
+        /** Returns the Value of a member.
+          * Searching with an interned name only compares pointers.
+          * @param  name the name of the member
+          * @return the members Value
+          */
+        Value getMember(const MemberName &name) const;
+
         /** Tests if a member exists.
           * @param  name the name of the member
           * @return true, if the member exists
           */
         bool hasMember(const std::string &name) const;
 
+        /** Tests if a member exists.
+          * Searching with an interned name only compares pointers.
+          * @param  name the name of the member
+          * @return true, if the member exists
+          */
+        bool hasMember(const MemberName &name) const;
+
         /** Returns the number of array members.
           * @return the array size
           */
@@ -928,14 +1474,19 @@ namespace ulxr {
           */
         static std::string getValueName();
 
-        /** Returns the value as xml string.
+        /** Writes the value as xml to a sink.
           * The content and its type name is converted to an xml text.
-          * The structure of the text is indented to facilitate easy reading
-          * of larger blocks.
+          * @param  sink     receives the xml content
           * @param  indent   current indentation level
-          * @return  The xml content
           */
-        virtual std::string getXml(int indent = 0) const;
+        virtual void serialize(XmlSink &sink, int indent = 0) const;
+
+        /** Returns the size of the xml which \c serialize() writes.
+          * @param  options  settings for the generated xml
+          * @param  indent   current indentation level
+          * @return  number of characters
+          */
+        virtual std::size_t getXmlSize(const XmlWriterOptions &options, int indent = 0) const;
 
         /** Returns the value as C++ structure declaration.
          * @param  name the declaration name
@@ -947,9 +1498,15 @@ namespace ulxr {
           */
         void clear();
 
+        /** Returns the order of the members.
+          * @return the member order
+          */
+        MemberOrder getMemberOrder() const;
+
     protected:
 
-        typedef std::map<std::string, Value>  Members;
+        typedef std::pair<MemberName, Value>   Member_pair;
+        typedef std::pmr::vector<Member_pair>  Members;
 
         /** Returns all elements of the Struct.
           */
@@ -957,9 +1514,45 @@ namespace ulxr {
 
     private:
 
-        typedef std::pair<std::string, Value> Member_pair;
+        friend class ValueArena;
+
+        /** Constructs an empty Struct inside an arena.
+          * @param  resource  memory for the members
+          */
+        explicit Struct (std::pmr::memory_resource *resource);
+
+        /** Searches a member.
+          * @param  name the name of the member, std::string or MemberName
+          * @return index of the member or size() if not found
+          */
+        template <class N>
+        unsigned findMember(const N &name) const;
 
-        Members val;
+        /** Appends a member unless a member with this name already exists.
+          * @param  name the name of the member
+          * @param  item its content
+          */
+        template <class V>
+        void appendMember(const MemberName &name, V &&item);
+
+        /** Sorts the members by name if some were added out of order.
+          */
+        void ensureSorted() const;
+
+        /** Enters a member into the hash index.
+          * @param  pos  position of the member
+          */
+        void indexMember(unsigned pos) const;
+
+        /** Rebuilds the hash index for the current members.
+          */
+        void rebuildIndex() const;
+
+        // sorted lazily by const methods, see ensureSorted()
+        mutable Members                     val;
+        mutable std::pmr::vector<unsigned>  slots;  // hash index: member position + 1, 0 = empty
+        MemberOrder                         order;
+        mutable std::atomic<bool>           sorted; // false: members were appended out of order
     };
 
 
@@ -1028,10 +1621,30 @@ namespace ulxr {
           */
         RpcString (const std::string &s);
 
+        /** Creates an RpcString as duplicate of another RpcString.
+          * @param  other  the source string
+          */
+        RpcString (const RpcString &other);
+
+        /** Creates an RpcString by taking over the content of another RpcString.
+          * @param  other  the source string, empty afterwards
+          */
+        RpcString (RpcString &&other);
+
         /** Destroys the Value
           */
         virtual ~RpcString ();
 
+        /** Copies the content of another RpcString.
+          * @param  other  the source string
+          */
+        RpcString &operator= (const RpcString &other);
+
+        /** Takes over the content of another RpcString.
+          * @param  other  the source string, empty afterwards
+          */
+        RpcString &operator= (RpcString &&other);
+
 
         /** Sets a new content.
           * @param  newval  the new content in UTF8
@@ -1061,18 +1674,31 @@ namespace ulxr {
           */
         static std::string getValueName();
 
-        /** Returns the value as xml string.
+        /** Writes the value as xml to a sink.
           * The content and its type name is converted to an xml text.
-          * The structure of the text is indented to facilitate easy reading
-          * of larger blocks.
+          * @param  sink     receives the xml content
           * @param  indent   current indentation level
-          * @return  The xml content
           */
-        virtual std::string getXml(int indent = 0) const;
+        virtual void serialize(XmlSink &sink, int indent = 0) const;
+
+        /** Returns the size of the xml which \c serialize() writes.
+          * @param  options  settings for the generated xml
+          * @param  indent   current indentation level
+          * @return  number of characters
+          */
+        virtual std::size_t getXmlSize(const XmlWriterOptions &options, int indent = 0) const;
 
     private:
 
-        std::string val;
+        friend class ValueArena;
+
+        /** Constructs an RpcString inside an arena.
+          * @param  resource  memory for the content
+          * @param  s         value for the construction as UTF8 string
+          */
+        RpcString (std::pmr::memory_resource *resource, const std::string &s);
+
+        std::pmr::string val;
     };
 
 
@@ -1080,14 +1706,19 @@ namespace ulxr {
 
 
     /** Implementation of a date and time value.
-      * The format is according to ISO8601 and must currently be done
-      * on the users side as this class only provides transportation.
+      * The content is kept as a number of seconds without a time zone
+      * together with the form of the text it was created from, so it is
+      * formatted back exactly as it came in. Text which is no valid date
+      * is kept as it is and only transported.
       *
       * Though XmlRpc uses the ISO8601 specification, not all detail are intended
       * to be supported. Time zones, milliseconds, abbreviations and mybe more are
       * omited. Only the 17 bytes from a value like the following should be considered
       * implemented:
       *  @li \c 19980717T14:08:55.
+      *
+      * Besides this the forms with dashes in the date part and without colons
+      * in the time part are supported, e.g. \c 1998-07-17T140855.
       * @ingroup grp_ulxr_value_type
       */
     class  DateTime : public ValueBase
@@ -1136,6 +1767,18 @@ namespace ulxr {
                           bool add_dash = false,
                           bool add_colon = true);
 
+        /** Returns the content as std::time_t. The date is taken as local
+          * time like in \c setDateTime(const time_t&).
+          * @return the time value
+          * @throw ParameterException if the content is no valid date
+          */
+        std::time_t getTimeT() const;
+
+        /** Determines if the content is a valid date in one of the supported forms.
+          * @return true if the content is a valid date
+          */
+        bool isValid() const;
+
         /** Creates a copy of the actual object.
           * @return pointer to the copy
           */
@@ -1153,18 +1796,46 @@ namespace ulxr {
           */
         static std::string getValueName();
 
-        /** Returns the value as xml string.
+        /** Writes the value as xml to a sink.
           * The content and its type name is converted to an xml text.
-          * The structure of the text is indented to facilitate easy reading
-          * of larger blocks.
+          * @param  sink     receives the xml content
           * @param  indent   current indentation level
-          * @return  The xml content
           */
-        virtual std::string getXml(int indent = 0) const;
+        virtual void serialize(XmlSink &sink, int indent = 0) const;
+
+        /** Returns the size of the xml which \c serialize() writes.
+          * @param  options  settings for the generated xml
+          * @param  indent   current indentation level
+          * @return  number of characters
+          */
+        virtual std::size_t getXmlSize(const XmlWriterOptions &options, int indent = 0) const;
 
     private:
 
-        std::string val;
+        friend class ValueArena;
+
+        /** Constructs a DateTime inside an arena.
+          * @param  resource  unused, a valid date needs no memory
+          * @param  s         value for the construction as string
+          */
+        DateTime (std::pmr::memory_resource *resource, const std::string &s);
+
+        /** Writes the date to a buffer.
+          * @param  buf  buffer for at least 32 characters
+          * @return the end of the written characters
+          */
+        char *format(char *buf) const;
+
+        enum Form
+        {
+            WithDash    = 1,   // 1998-07-17
+            WithColon   = 2,   // 14:08:55
+            Verbatim    = 4    // no valid date, only text is used
+        };
+
+        std::int64_t   stamp;  // seconds since 1970-01-01T00:00:00, no time zone
+        unsigned char  form;
+        std::string    text;
     };
 
 
@@ -1176,6 +1847,10 @@ namespace ulxr {
       * To transport such data you must convert to something conforming to
       * XML rules. This is achived with base64 that uses only letters, digits
       * and some punctuation characters.
+      *
+      * The content is kept in the form it was supplied, encoded or raw.
+      * The other form is created on first use and then kept as well,
+      * so a value which is only passed on is never converted.
       * @ingroup grp_ulxr_value_type
       */
     class  Base64 : public ValueBase
@@ -1191,10 +1866,30 @@ namespace ulxr {
           */
         Base64 (const std::string &s);
 
+        /** Creates a Base64 as duplicate of another Base64.
+          * @param  other  the source value
+          */
+        Base64 (const Base64 &other);
+
+        /** Creates a Base64 by taking over the content of another Base64.
+          * @param  other  the source value, empty afterwards
+          */
+        Base64 (Base64 &&other);
+
         /** Destroys the Value
           */
         virtual ~Base64 ();
 
+        /** Copies the content of another Base64.
+          * @param  other  the source value
+          */
+        Base64 &operator= (const Base64 &other);
+
+        /** Takes over the content of another Base64.
+          * @param  other  the source value, empty afterwards
+          */
+        Base64 &operator= (Base64 &&other);
+
         /** Returns the current value.
           * @return current value
           */
@@ -1232,18 +1927,145 @@ namespace ulxr {
           */
         static std::string getValueName();
 
-        /** Returns the value as xml string.
+        /** Writes the value as xml to a sink.
           * The content and its type name is converted to an xml text.
-          * The structure of the text is indented to facilitate easy reading
-          * of larger blocks.
+          * @param  sink     receives the xml content
           * @param  indent   current indentation level
-          * @return  The xml content
           */
-        virtual std::string getXml(int indent = 0) const;
+        virtual void serialize(XmlSink &sink, int indent = 0) const;
+
+        /** Returns the size of the xml which \c serialize() writes.
+          * @param  options  settings for the generated xml
+          * @param  indent   current indentation level
+          * @return  number of characters
+          */
+        virtual std::size_t getXmlSize(const XmlWriterOptions &options, int indent = 0) const;
+
+    private:
+
+        friend class ValueArena;
+
+        /** Constructs a Base64 inside an arena.
+          * @param  resource  memory for the content
+          * @param  s         the already encoded value
+          */
+        Base64 (std::pmr::memory_resource *resource, const std::string &s);
+
+        /** Returns the encoded content, encoding it if necessary.
+          * @return the encoded content
+          */
+        const std::pmr::string &getEncoded() const;
+
+        /** Returns the raw content, decoding it if necessary.
+          * @return the raw content
+          */
+        const std::pmr::string &getDecoded() const;
+
+        enum Form
+        {
+            HasEncoded = 1,
+            HasDecoded = 2
+        };
+
+        mutable std::pmr::string           encoded;
+        mutable std::pmr::string           decoded;
+        mutable std::atomic<unsigned char> forms;   // Form bits of the valid members
+    };
+
+
+//////////////////////////////////////////////////////////////
+
+
+    /** A value which is already converted to xml.
+      * The xml of a complete <value> element is checked once when the
+      * RawXml is constructed and afterwards written as it is. Data which
+      * rarely changes like configuration trees or catalogs can be converted
+      * once and inserted into an Array or Struct of every response at the
+      * cost of a copy instead of a conversion.
+      *
+      * The content is not changed by the settings of the surrounding
+      * document except for the indentation of the first line, so it should
+      * be created without pretty-print. Parsing a document never creates
+      * a RawXml but the Value it contains.
+      * @ingroup grp_ulxr_value_type
+      */
+    class  RawXml : public ValueBase
+    {
+    public:
+
+        /** Constructs a RawXml from xml text.
+          * Surrounding white space is removed.
+          * @param  xml   a single <value> element
+          * @throw ParameterException if \c xml is no valid value
+          */
+        explicit RawXml (const std::string &xml);
+
+        /** Constructs a RawXml from xml text.
+          * @param  xml   a single <value> element
+          * @throw ParameterException if \c xml is no valid value
+          */
+        explicit RawXml (const char *xml);
+
+        /** Creates a RawXml by taking over the content of another RawXml.
+          * @param  other  the source value, empty afterwards
+          */
+        RawXml (RawXml &&other);
+
+        /** Creates a RawXml as duplicate of another RawXml.
+          * @param  other  the source value
+          */
+        RawXml (const RawXml &other);
+
+        /** Constructs a RawXml by converting a Value without pretty-print.
+          * @param  val   the value to convert
+          */
+        explicit RawXml (const Value &val);
+
+        /** Constructs a RawXml by converting a Value.
+          * @param  val       the value to convert
+          * @param  options   settings for the generated xml
+          */
+        RawXml (const Value &val, const XmlWriterOptions &options);
+
+        /** Destroys the Value
+          */
+        virtual ~RawXml ();
+
+        /** Returns the xml of the value.
+          * @return the <value> element
+          */
+        const std::string &getFragment() const;
+
+        /** Creates a copy of the actual object.
+          * @return pointer to the copy
+          */
+        virtual ValueBase* cloneValue() const;
+
+        /** Returns the signature of the contained value.
+          * @param deep  if nested types exist, include them
+          * @return  The signature
+          */
+        virtual std::string getSignature(bool deep = false) const;
+
+        /** Writes the value as xml to a sink.
+          * The xml is copied without any changes.
+          * @param  sink     receives the xml content
+          * @param  indent   current indentation level
+          */
+        virtual void serialize(XmlSink &sink, int indent = 0) const;
+
+        /** Returns the size of the xml which \c serialize() writes.
+          * @param  options  settings for the generated xml
+          * @param  indent   current indentation level
+          * @return  number of characters
+          */
+        virtual std::size_t getXmlSize(const XmlWriterOptions &options, int indent = 0) const;
 
     private:
 
-        std::string val;
+        std::string  xml;
+        std::string  signature;
+        std::string  deepSignature;
     };
 
 
@@ -33,7 +33,6 @@
 #include <ulxmlrpcpp/ulxmlrpcpp.h>
 
 #include <memory>
-#include <cstring>
 
 #include <ulxmlrpcpp/ulxr_valueparse.h>
 #include <ulxmlrpcpp/ulxr_except.h>
@@ -48,42 +47,77 @@ namespace ulxr {
 
     ValueParser::ValueParser()
         : ValueParserBase()
+        , depth(0)
     {
         ULXR_TRACE("ValueParser::ValueParser()");
-        states.push(new ValueState(eNone));
+        states.reserve(16);
+        pushState(eNone);
     }
 
 
     ValueParser::~ValueParser()
     {
         ULXR_TRACE("ValueParser::~ValueParser()");
+    }
 
-        while (states.size() != 0)
-        {
-            if (getTopValueState()->canDelete())
-                delete getTopValueState()->getValue();
-            delete getTopValueState();
-            states.pop();
-        }
+
+    ValueParserBase::ValueState* ValueParser::getTopValueState() const
+    {
+        ULXR_TRACE("ValueParser::getTopState() size: " << depth);
+        return const_cast<ValueState*>(&states[depth-1]);
     }
 
 
+    ValueParserBase::ValueState* ValueParser::getParentValueState() const
+    {
+        return const_cast<ValueState*>(&states[depth-2]);
+    }
 
-    ValueParserBase::ValueState* ValueParser::getTopValueState() const
+
+    void ValueParser::pushState(unsigned st)
     {
-        ULXR_TRACE("ValueParser::getTopState() size: " << states.size());
-#ifdef DEBUG
-        ValueState *vs = dynamic_cast<ValueState*> (states.top());      // be careful about type
-        if (vs == 0)
-        {
-            ULXR_TRACE("ValueParser::getTopState(), top state: " << (void*) states.top());
-            ULXR_TRACE("ValueParser::getTopState(): state <> ValueState");
-            ULXR_TRACE("ValueParser::getTopState(): state == " << typeid(states.top()).name());
-        }
-        return vs;
-#else
-        return reinterpret_cast<ValueParserBase::ValueState*> (states.top());  // dont care anymore
-#endif
+        if (depth == states.size())
+            states.push_back(ValueState());
+        states[depth++].reset(st, getCharDataEnd());
+    }
+
+
+    void ValueParser::pushState(unsigned st, Value &&val)
+    {
+        if (depth == states.size())
+            states.push_back(ValueState());
+        states[depth++].reset(st, getCharDataEnd(), std::move(val));
+    }
+
+
+    void ValueParser::popState()
+    {
+        --depth;
+        releaseCharData(states[depth]);
+        states[depth].clear();
+    }
+
+
+    std::size_t ValueParser::numStates() const
+    {
+        return depth;
+    }
+
+
+    void ValueParser::assertEndElement(const XML_Char *current, Tag expected)
+    {
+        if (getTag(current) != expected)
+            XmlParser::assertEndElement(current, getTagName(expected));
+    }
+
+
+    void ValueParser::assertValidContent(bool valid, const char *name, const std::string &data)
+    {
+        if (!valid)
+            throw XmlException(NotConformingError,
+                               std::string("Invalid ") + name + " value: " + data,
+                               getCurrentLineNumber(),
+                               "Document not conforming");
     }
 
 
@@ -103,64 +137,46 @@ namespace ulxr {
                    << "\n  name: "
                    << name
                   );
+        const Tag tag = getTag(name);
         switch(getTopValueState()->getParserState() )
         {
         case eNone:
-            if (strcmp(name, "value") == 0)
-                states.push(new ValueState(eValue));
+            if (tag == eTagValue)
+                pushState(eValue);
             else
                 return false;
             break;
 
         case eValue:
-            if (strcmp(name, "array") == 0)
-                states.push(new ValueState(eArray));
-
-            else if (strcmp(name, "struct") == 0)
-                states.push(new ValueState(eStruct));
-
-            else if (strcmp(name, "boolean") == 0)
-                states.push(new ValueState(eBoolean));
-
-            else if (strcmp(name, "int") == 0)
-                states.push(new ValueState(eInt));
-
-            else if (strcmp(name, "i4") == 0)
-                states.push(new ValueState(eI4));
-
-            else if (strcmp(name, "double") == 0)
-                states.push(new ValueState(eDouble));
-
-            else if (strcmp(name, "string") == 0)
-                states.push(new ValueState(eString));
-
-            else if (strcmp(name, "base64") == 0)
-                states.push(new ValueState(eBase64));
-
-            else if (strcmp(name, "dateTime.iso8601") == 0)
-                states.push(new ValueState(eDate));
-
-            else
+            switch (tag)
+            {
+            case eTagArray:   pushState(eArray);   break;
+            case eTagStruct:  pushState(eStruct);  break;
+            case eTagBoolean: pushState(eBoolean); break;
+            case eTagInt:     pushState(eInt);     break;
+            case eTagI4:      pushState(eI4);      break;
+            case eTagDouble:  pushState(eDouble);  break;
+            case eTagString:  pushState(eString);  break;
+            case eTagBase64:  pushState(eBase64);  break;
+            case eTagDate:    pushState(eDate);    break;
+            default:
                 return false;
+            }
             break;
 
         case eStruct:
-            if (strcmp(name, "member") == 0)
-            {
-                if (getTopValueState()->getValue() == 0)  // first closing member adds struct-item
-                    getTopValueState()->takeValue(new Value(Struct()), false);
-                states.push(new MemberState(eMember, getTopValueState()->getValue()));
-            }
+            if (tag == eTagMember)
+                pushState(eMember);
             else
                 return false;
             break;
 
         case eMember:
-            if (strcmp(name, "name") == 0)
-                states.push(new ValueState(eName));
+            if (tag == eTagName)
+                pushState(eName);
 
-            else if (strcmp(name, "value") == 0)
-                states.push(new ValueState(eValue));
+            else if (tag == eTagValue)
+                pushState(eValue);
 
             else
                 return false;
@@ -168,15 +184,15 @@ namespace ulxr {
             break;
 
         case eArray:
-            if (strcmp(name, "data") == 0)
-                states.push(new ArrayState(eData));
+            if (tag == eTagData)
+                pushState(eData, createArray());
             else
                 return false;
             break;
 
         case eData:
-            if (strcmp(name, "value") == 0)  // closing value adds data-items
-                states.push(new ValueState(eValue));
+            if (tag == eTagValue)  // closing value adds data-items
+                pushState(eValue);
             else
                 return false;
             break;
@@ -201,100 +217,108 @@ namespace ulxr {
     {
         ULXR_TRACE("ValueParser::testEndElement(const XML_Char*)");
 
-        if (states.size() <= 1)
+        if (depth <= 1)
             throw RuntimeException(ApplicationError, "abnormal program behaviour: ValueParser::testEndElement() had no states left");
 
-        std::unique_ptr<ValueState> curr(getTopValueState());
-        states.pop();
-        states.top()->setPrevParserState(curr->getParserState());
+        ValueState *curr = getTopValueState();
+        ValueState *on_top = getParentValueState();
+        on_top->setPrevParserState(curr->getParserState());
         switch(curr->getParserState() )
         {
         case eBoolean:
-            assertEndElement(name, "boolean");
-            getTopValueState()->takeValue(new Value(Boolean(curr->getCharData())) );
+            assertEndElement(name, eTagBoolean);
+            on_top->takeValue(Value(Boolean(getCharData(*curr))));
             break;
 
         case eInt:
-            assertEndElement(name, "int");
-            getTopValueState()->takeValue(new Value(Integer(curr->getCharData())) );
-            break;
-
         case eI4:
-            assertEndElement(name, "i4");
-            getTopValueState()->takeValue(new Value(Integer(curr->getCharData())) );
+            assertEndElement(name, curr->getParserState() == eInt ? eTagInt : eTagI4);
+            {
+                int i = 0;
+                const std::string &data = getCharData(*curr);
+                assertValidContent(Integer::parse(data, i), name, data);
+                on_top->takeValue(Value(Integer(i)));
+            }
             break;
 
         case eDouble:
-            assertEndElement(name, "double");
-            getTopValueState()->takeValue(new Value(Double(curr->getCharData())) );
+            assertEndElement(name, eTagDouble);
+            {
+                double d = 0;
+                const std::string &data = getCharData(*curr);
+                assertValidContent(Double::parse(data, d), name, data);
+                on_top->takeValue(Value(Double(d)));
+            }
             break;
 
         case eString:
-            assertEndElement(name, "string");
-            getTopValueState()->takeValue(new Value(RpcString(curr->getCharData())) );
+            assertEndElement(name, eTagString);
+            on_top->takeValue(createString(getCharData(*curr)));
             break;
 
         case eBase64:
-        {
-            assertEndElement(name, "base64");
-            Base64 b64;
-            b64.setBase64(curr->getCharData()); // move raw data!
-            getTopValueState()->takeValue(new Value(b64));
-        }
-        break;
+            assertEndElement(name, eTagBase64);
+            on_top->takeValue(createBase64(getCharData(*curr)));
+            break;
 
         case eDate:
-            assertEndElement(name , "dateTime.iso8601");
-            getTopValueState()->takeValue(new Value(DateTime(curr->getCharData())) );
+            assertEndElement(name, eTagDate);
+            {
+                const std::string &data = getCharData(*curr);
+                Value date(createDateTime(data));
+                assertValidContent(static_cast<const DateTime&>(date).isValid(), name, data);
+                on_top->takeValue(std::move(date));
+            }
             break;
 
         case eMember:
-            assertEndElement(name, "member");
-            getTopValueState()->takeValue (curr->getValue());
+            assertEndElement(name, eTagMember);
+            if (collectMember(*curr))
+                on_top->countMember();
             break;
 
         case eName:
-            assertEndElement(name, "name");
-            getTopValueState()->takeName((curr->getCharData()) );
+            assertEndElement(name, eTagName);
+            on_top->takeName(getMemberName(getCharData(*curr)));
             break;
 
         case eValue:
-            assertEndElement(name, "value");
-            if (curr->getValue() == 0)     // special case
+            assertEndElement(name, eTagValue);
+            if (!curr->hasValue())     // special case
             {
                 if(curr->getPrevParserState() == eArray)            // not empty Array
-                    getTopValueState()->takeValue (new Value(Array()));
+                    on_top->takeValue (createArray());
 
                 else if (curr->getPrevParserState() == eStruct)     // not empty Struct
-                    getTopValueState()->takeValue (new Value(Struct()));
+                    on_top->takeValue (createStruct());
 
                 else                                                // no type tag defaults to string
-                    getTopValueState()->takeValue (new Value(RpcString(curr->getCharData())));
+                    on_top->takeValue (createString(getCharData(*curr)));
             }
             else
-                getTopValueState()->takeValue (curr->getValue());
+                on_top->takeValue (curr->releaseValue());
             break;
 
         case eStruct:
-            assertEndElement(name, "struct");
-            getTopValueState()->takeValue (curr->getValue());
+            assertEndElement(name, eTagStruct);
+            on_top->takeValue (createStruct(curr->numMembers()));
             break;
 
         case eArray:
-            assertEndElement(name, "array");
-            getTopValueState()->takeValue (curr->getValue());
+            assertEndElement(name, eTagArray);
+            on_top->takeValue (curr->releaseValue());
             break;
 
         case eData:
-            assertEndElement(name, "data");
-            getTopValueState()->takeValue (curr->getValue());
+            assertEndElement(name, eTagData);
+            on_top->takeValue (curr->releaseValue());
             break;
 
         default:
-            states.push(curr.release());
             return false;
         }
 
+        popState();
         return true;
     }
 
@@ -35,7 +35,7 @@
 #include <ulxmlrpcpp/ulxr_xmlparse.h>
 #include <ulxmlrpcpp/ulxr_valueparse_base.h>
 
-#include <stack>
+#include <vector>
 
 
 namespace ulxr {
@@ -48,7 +48,7 @@ namespace ulxr {
       * automatically destroyed. The object taking over the "Value" resp. the object
       * storing the value somehow else must "delete" the "Value" it gets.
       *
-      * @see ArrayState::takeValue
+      * @see ValueState::takeValue
       * @see MethodCallParser::testEndElement
       * @ingroup grp_ulxr_parser
       */
@@ -100,6 +100,54 @@ namespace ulxr {
           * @return pointer to ValueState
           */
         ValueState *getTopValueState() const;
+
+        /** Gets a pointer to the ValueState below the topmost one.
+          * @return pointer to ValueState
+          */
+        ValueState *getParentValueState() const;
+
+        /** Puts a new ValueState on top of the stack.
+          * The states of former elements are reused, so parsing does not
+          * allocate for each element.
+          * @param  st      the actual state
+          */
+        void pushState(unsigned st);
+
+        /** Puts a new ValueState on top of the stack.
+          * @param  st      the actual state
+          * @param  val     the Array to fill
+          */
+        void pushState(unsigned st, Value &&val);
+
+        /** Removes the topmost ValueState together with its character data.
+          * A Value which was not taken over before is destroyed.
+          */
+        void popState();
+
+        /** Gets the number of states on the stack.
+          * @return the number of states
+          */
+        std::size_t numStates() const;
+
+        using XmlParser::assertEndElement;
+
+        /** Checks if the closing tag is the expected xml-rpc element.
+          * @param  current   the name of the current tag
+          * @param  expected  the expected element
+          */
+        void assertEndElement(const XML_Char *current, Tag expected);
+
+        /** Throws an exception if the content of an element is not valid.
+          * @param  valid  result of the check of the content
+          * @param  name   the name of the current tag
+          * @param  data   the content
+          */
+        void assertValidContent(bool valid, const char *name, const std::string &data);
+
+    private:
+
+        std::vector<ValueState>  states;
+        std::size_t              depth;
     };
 
 
@@ -33,99 +33,240 @@
 #include <ulxmlrpcpp/ulxmlrpcpp.h>
 
 #include <ulxmlrpcpp/ulxr_valueparse_base.h>
+#include <ulxmlrpcpp/ulxr_arena.h>
+
+#include <utility>
+#include <cstring>
 
 
 namespace ulxr {
 
 
+    namespace {
+
+        struct TagName
+        {
+            const char   *name;
+            std::size_t   len;
+        };
+
+        // indexed by ValueParserBase::Tag
+        constexpr TagName tagNames[] =
+        {
+            { "",                 0 },
+            { "value",            5 },
+            { "array",            5 },
+            { "data",             4 },
+            { "struct",           6 },
+            { "member",           6 },
+            { "name",             4 },
+            { "boolean",          7 },
+            { "int",              3 },
+            { "i4",               2 },
+            { "double",           6 },
+            { "string",           6 },
+            { "base64",           6 },
+            { "dateTime.iso8601", 16 },
+            { "methodCall",       10 },
+            { "methodName",       10 },
+            { "params",           6 },
+            { "param",            5 },
+            { "methodResponse",   14 },
+            { "fault",            5 }
+        };
+
+        static_assert(sizeof(tagNames) / sizeof(tagNames[0]) == ValueParserBase::eTagLast,
+                      "every tag needs a name");
+
+        constexpr unsigned tagSlots = 64;
+
+        constexpr unsigned tagHash(std::size_t len, char first, char last)
+        {
+            return (len * 2 + static_cast<unsigned char>(first)
+                            + static_cast<unsigned char>(last) * 8) % tagSlots;
+        }
+
+        struct TagTable
+        {
+            unsigned char  slots[tagSlots];
+            bool           perfect;
+        };
+
+        constexpr TagTable makeTagTable()
+        {
+            TagTable table = {};
+            table.perfect = true;
+            for (unsigned tag = ValueParserBase::eTagUnknown+1; tag < ValueParserBase::eTagLast; ++tag)
+            {
+                const TagName &tn = tagNames[tag];
+                const unsigned slot = tagHash(tn.len, tn.name[0], tn.name[tn.len-1]);
+                if (table.slots[slot] != ValueParserBase::eTagUnknown)
+                    table.perfect = false;
+                table.slots[slot] = tag;
+            }
+            return table;
+        }
+
+        constexpr TagTable tagTable = makeTagTable();
+
+        static_assert(tagTable.perfect, "tagHash() must not map two tags to the same slot");
+
+    }  // namespace
+
+
+    ValueParserBase::Tag ValueParserBase::getTag(const XML_Char *name)
+    {
+        const std::size_t len = std::strlen(name);
+        if (len == 0)
+            return eTagUnknown;
+
+        const unsigned tag = tagTable.slots[tagHash(len, name[0], name[len-1])];
+        if (tagNames[tag].len == len && std::memcmp(tagNames[tag].name, name, len) == 0)
+            return static_cast<Tag>(tag);
+
+        return eTagUnknown;
+    }
+
+
+    const char *ValueParserBase::getTagName(Tag tag)
+    {
+        return tagNames[tag].name;
+    }
+
+
+    ValueParserBase::ValueParserBase()
+        : arena(0)
+    {
+    }
+
+
     ValueParserBase::~ValueParserBase()
     {
+        useArena(false);
     }
 
 
-    Value ValueParserBase::getValue() const
+    void ValueParserBase::useArena(bool enable)
     {
-        ULXR_TRACE("ValueParserBase::getValue()");
-        Value *v = getTopValueState()->getValue();
-        if (v != 0)
-            return *v;
-        else
-            return Value(); // return ulxr::Void()
+        if (enable && arena == 0)
+            arena = new ValueArena;
+
+        else if (!enable && arena != 0)
+        {
+            arena->release();
+            arena = 0;
+        }
     }
 
 
-//////////////////////////////////////////////////////////////////////////////
-//
+    bool ValueParserBase::isArenaUsed() const
+    {
+        return arena != 0;
+    }
 
 
-    ValueParserBase::ValueState::ValueState (unsigned st)
-        : XmlParserBase::ParserState(st)
-        , value (0)
-        , candel(true)
+    Value ValueParserBase::createArray()
     {
+        if (arena == 0)
+            return Value(Array());
+
+        Value v;
+        v.adopt(arena->create<Array>());
+        return v;
     }
 
 
-    void ValueParserBase::ValueState::takeValue(Value *val, bool del)
+    Value ValueParserBase::createStruct()
     {
-        ULXR_TRACE("ValueParserBase::ValueState::takeValue(Value *)");
-        value = val;
-        candel = del;
+        if (arena == 0)
+            return Value(Struct());
+
+        Value v;
+        v.adopt(arena->create<Struct>());
+        return v;
     }
 
 
-    bool ValueParserBase::ValueState::canDelete() const
+    Value ValueParserBase::createStruct(std::size_t num)
     {
-        return candel;
+        Value v = createStruct();
+        Struct *st = v.modifyStruct();
+        st->reserve(num);
+
+        const std::size_t first = members.size() - num;
+        for (std::size_t i = first; i < members.size(); ++i)
+            st->addMember(members[i].first, std::move(members[i].second));
+
+        members.erase(members.begin() + first, members.end());
+        return v;
     }
 
 
-    std::string ValueParserBase::ValueState::getStateName() const
+    const MemberName &ValueParserBase::getMemberName(const std::string &name)
     {
-        switch (getParserState())
-        {
-        case XmlParserBase::eNone     : return "eNone";
-        case ValueParserBase::eValue  : return "eValue";
-        case ValueParserBase::eArray  : return "eArray";
-        case ValueParserBase::eData   : return "eData";
-        case ValueParserBase::eStruct : return "eStruct";
-        case ValueParserBase::eMember : return "eMember";
-        case ValueParserBase::eName   : return "eName";
-        case ValueParserBase::eBoolean: return "eBoolean";
-        case ValueParserBase::eInt    : return "eInt";
-        case ValueParserBase::eI4     : return "eI4";
-        case ValueParserBase::eDouble : return "eDouble";
-        case ValueParserBase::eString : return "eString";
-        case ValueParserBase::eBase64 : return "eBase64";
-        case ValueParserBase::eDate   : return "eDate";
+        std::size_t slot = name.length();
+        if (slot != 0)
+            slot = slot * 31 + static_cast<unsigned char>(name[0]) * 7
+                             + static_cast<unsigned char>(name[slot-1]);
+
+        MemberName &cached = names[slot % NameCacheSize];
+        if (cached.str() != name)
+            cached = MemberName(name);
+        return cached;
+    }
 
-        case ValueParserBase::eValueParserLast: return "eValueParserLast";
-        }
 
-        return "eUnknown";
+    bool ValueParserBase::collectMember(ValueState &member)
+    {
+        if (member.getName().empty() || !member.hasValue())
+            return false;
+
+        members.push_back(std::make_pair(member.getName(), member.releaseValue()));
+        return true;
     }
 
 
-    void ValueParserBase::ValueState::takeName(const std::string & /* name */ )
+    Value ValueParserBase::createString(const std::string &s)
     {
+        if (arena == 0)
+            return Value(RpcString(s));
+
+        Value v;
+        v.adopt(arena->create<RpcString>(s));
+        return v;
     }
 
 
-    std::string ValueParserBase::ValueState::getName() const
+    Value ValueParserBase::createBase64(const std::string &s)
     {
-        return name;
+        if (arena == 0)
+        {
+            Base64 b64;
+            b64.setBase64(s); // move raw data!
+            return Value(std::move(b64));
+        }
+
+        Value v;
+        v.adopt(arena->create<Base64>(s));
+        return v;
     }
 
 
-    void ValueParserBase::ValueState::setName(const std::string &nm)
+    Value ValueParserBase::createDateTime(const std::string &s)
     {
-        name = nm;
+        if (arena == 0)
+            return Value(DateTime(s));
+
+        Value v;
+        v.adopt(arena->create<DateTime>(s));
+        return v;
     }
 
 
-    Value* ValueParserBase::ValueState::getValue() const
+    Value ValueParserBase::getValue() const
     {
-        return value;
+        ULXR_TRACE("ValueParserBase::getValue()");
+        return getTopValueState()->getValue();
     }
 
 
@@ -133,61 +274,113 @@ namespace ulxr {
 //
 
 
-    ValueParserBase::MemberState::MemberState(unsigned st, Value *val)
-        : ValueState(st),
-          mem_val(0)
+    ValueParserBase::ValueState::ValueState (unsigned st, std::size_t cdata_start)
+        : XmlParserBase::ParserState(st, cdata_start)
+        , members(0)
     {
-        value = val;
     }
 
 
-    void ValueParserBase::MemberState::takeValue(Value *v, bool del)
+    void ValueParserBase::ValueState::reset(unsigned st, std::size_t cdata_start)
     {
-        candel = del;
-        ULXR_TRACE("ValueParserBase::MemberState::takeValue(Value *)");
-        if (getName().length() != 0) // wait for name, maybe second tag
-        {
-            value->getStruct()->addMember(getName(), *v);
-            delete v;
-        }
+        XmlParserBase::ParserState::operator=(XmlParserBase::ParserState(st, cdata_start));
+    }
+
+
+    void ValueParserBase::ValueState::reset(unsigned st, std::size_t cdata_start, Value &&val)
+    {
+        reset(st, cdata_start);
+        value = std::move(val);
+    }
+
+
+    void ValueParserBase::ValueState::clear()
+    {
+        if (!value.isVoid())
+            value = Value();
+        if (!mem_name.empty())
+            mem_name = MemberName();
+        members = 0;
+    }
+
+
+    void ValueParserBase::ValueState::takeValue(Value &&v)
+    {
+        ULXR_TRACE("ValueParserBase::ValueState::takeValue(Value &&)");
+        if (getParserState() == ValueParserBase::eData)
+            value.modifyArray()->addItem(std::move(v));
         else
-            mem_val = v;
+            value = std::move(v);
+    }
+
+
+    void ValueParserBase::ValueState::countMember()
+    {
+        ++members;
+    }
+
+
+    std::size_t ValueParserBase::ValueState::numMembers() const
+    {
+        return members;
     }
 
 
-    void ValueParserBase::MemberState::takeName(const std::string &n)
+    std::string ValueParserBase::ValueState::getStateName() const
     {
-        if (mem_val != 0)
+        switch (getParserState())
         {
-            value->getStruct()->addMember(n, *mem_val);
-            delete mem_val;
-            mem_val = 0;
+        case XmlParserBase::eNone     : return "eNone";
+        case ValueParserBase::eValue  : return "eValue";
+        case ValueParserBase::eArray  : return "eArray";
+        case ValueParserBase::eData   : return "eData";
+        case ValueParserBase::eStruct : return "eStruct";
+        case ValueParserBase::eMember : return "eMember";
+        case ValueParserBase::eName   : return "eName";
+        case ValueParserBase::eBoolean: return "eBoolean";
+        case ValueParserBase::eInt    : return "eInt";
+        case ValueParserBase::eI4     : return "eI4";
+        case ValueParserBase::eDouble : return "eDouble";
+        case ValueParserBase::eString : return "eString";
+        case ValueParserBase::eBase64 : return "eBase64";
+        case ValueParserBase::eDate   : return "eDate";
+
+        case ValueParserBase::eValueParserLast: return "eValueParserLast";
         }
-        else
-            setName(n);
+
+        return "eUnknown";
     }
 
 
-//////////////////////////////////////////////////////////////////////////////
-//
+    void ValueParserBase::ValueState::takeName(const MemberName &n)
+    {
+        if (getParserState() == ValueParserBase::eMember)
+            mem_name = n;
+    }
+
+
+    bool ValueParserBase::ValueState::hasValue() const
+    {
+        return !value.isVoid();
+    }
 
-    ValueParserBase::ArrayState::ArrayState(unsigned st)
-        : ValueState(st)
+
+    const MemberName &ValueParserBase::ValueState::getName() const
     {
+        return mem_name;
     }
 
 
-    void ValueParserBase::ArrayState::takeValue(Value *v, bool del)
+    const Value &ValueParserBase::ValueState::getValue() const
     {
-        candel = del;
-        ULXR_TRACE("ValueParserBase::ArrayState::takeValue(Value *)");
-        if (value == 0)
-            value = new Value(Array());
+        return value;
+    }
+
 
-        value->getArray()->addItem(*v);
-        delete v;
+    Value ValueParserBase::ValueState::releaseValue()
+    {
+        return std::move(value);
     }
 
 
 }  // namespace ulxr
-
@@ -35,28 +35,46 @@
 #include <ulxmlrpcpp/ulxr_value.h>
 #include <ulxmlrpcpp/ulxr_xmlparse_base.h>
 
+#include <utility>
+#include <vector>
+
 
 namespace ulxr {
 
 
     /** Base class for  RPC parsing.
       *
-      * IMPORTANT:
-      * The current "Value" is moved around via pointers and is not
-      * automatically destroyed. The object taking over the "Value" resp. the object
-      * storing the value somehow else must "delete" the "Value" it gets.
+      * Each ValueState holds the Value of its element and moves it into
+      * the state of the enclosing element when the element is complete.
       *
-      * @see ArrayState::takeValue
+      * @see ValueState::takeValue
       * @ingroup grp_ulxr_parser
       */
     class  ValueParserBase
     {
     public:
 
+        /** Constructs a parser which allocates the values from the heap.
+         */
+        ValueParserBase();
+
         /** Destroy parser.
          */
         virtual ~ValueParserBase();
 
+        /** Selects where the parsed values are allocated.
+         * In arena mode the complete tree is carved out of one ValueArena
+         * which is freed in one go together with the last Value
+         * referring to it. Must be set before parsing starts.
+         * @param  enable  true: allocate from an arena
+         */
+        void useArena(bool enable);
+
+        /** Tests if the parsed values are allocated from an arena.
+         * @return true in arena mode
+         */
+        bool isArenaUsed() const;
+
         /** Gets the final Value after parsing.
          * @return the Value.
          */
@@ -72,137 +90,190 @@ namespace ulxr {
             eValueParserLast
         };
 
+        /** The elements of the xml-rpc vocabulary, including calls and responses.
+          */
+        enum Tag
+        {
+            eTagUnknown,
+            eTagValue,      eTagArray,      eTagData,
+            eTagStruct,     eTagMember,     eTagName,
+            eTagBoolean,    eTagInt,        eTagI4,       eTagDouble,
+            eTagString,     eTagBase64,     eTagDate,
+            eTagMethodCall, eTagMethodName, eTagParams,   eTagParam,
+            eTagMethodResponse,             eTagFault,
+            eTagLast
+        };
+
+        /** Classifies the name of an xml element.
+          * A perfect hash over the length, the first and the last character
+          * selects the only possible element which is then compared once.
+          * @param  name  the name of the element
+          * @return the element, \c eTagUnknown if it is not part of xml-rpc
+          */
+        static Tag getTag(const XML_Char *name);
+
+        /** Gets the name of an xml element.
+          * @param  tag  the element
+          * @return the name as it appears in xml
+          */
+        static const char *getTagName(Tag tag);
+
         /** Helper class to represent the data of the current parsing step.
+          * A ValueState in the state \c eMember keeps the name and the value
+          * of the member until it is collected for the enclosing Struct,
+          * a ValueState in the state \c eStruct counts these members and
+          * a ValueState in the state \c eData collects the items of an Array.
           */
         class  ValueState : public XmlParserBase::ParserState
         {
         public:
 
-            /** Constructs an ValueState.
-              * @param  st  the actual state
+            /** Constructs a ValueState.
+              * @param  st           the actual state
+              * @param  cdata_start  the position of the character data in the parser
               */
-            ValueState (unsigned st);
+            ValueState (unsigned st = XmlParserBase::eNone, std::size_t cdata_start = 0);
 
-            /** Transfers a Value into the ValueState.
-              * @param  val   the value
-              * @param  candel: @li true:  value is unique here, delete at end
-              *                 @li false: value is shared here, delete it somewhere else
+            /** Prepares a cleared ValueState for another element.
+              * @param  st           the actual state
+              * @param  cdata_start  the position of the character data in the parser
               */
-            virtual void takeValue(Value *val, bool candel = true);
+            void reset(unsigned st, std::size_t cdata_start);
 
-            virtual bool canDelete() const;
+            /** Prepares a cleared ValueState for another element.
+              * @param  st           the actual state
+              * @param  cdata_start  the position of the character data in the parser
+              * @param  val          the Array to fill
+              */
+            void reset(unsigned st, std::size_t cdata_start, Value &&val);
+
+            /** Drops a Value or member name which was not taken over.
+              */
+            void clear();
+
+            /** Moves a Value into the ValueState.
+              * A state \c eData appends it to its Array, other states keep it.
+              * @param  val   the value
+              */
+            void takeValue(Value &&val);
 
             /** Transfers a member name into the ValueState.
               * Used only for Structs.
               * @param  name   the member name
               */
-            virtual void takeName(const std::string &name);
+            void takeName(const MemberName &name);
+
+            /** Counts a member which was collected for the Struct.
+              */
+            void countMember();
+
+            /** Gets the number of members collected for the Struct.
+              * @return the number of members
+              */
+            std::size_t numMembers() const;
 
             /** Gets the name of the state.
               * Useful only for debugging.
               * @return the name of actual state
               */
-            virtual std::string getStateName() const;
+            std::string getStateName() const;
 
-            /** Gets the name of the member.
-              * Used only with Structs
-              * @return the member name
+            /** Tests if the state has received a Value.
+              * @return true if there is a Value
               */
-            std::string getName() const;
+            bool hasValue() const;
 
-            /** Sets the name of the member.
-              * Used only with Structs
-              * @param  name   the member name
+            /** Gets the member name of this state.
+              * @return the name, empty if there is none
               */
-            void setName(const std::string &name);
+            const MemberName &getName() const;
 
             /** Gets the Value of this state.
-              * @return the Value.
+              * @return the Value, Void if there is none
               */
-            Value* getValue() const;
+            const Value &getValue() const;
 
-        protected:
-
-            Value     *value;
-            bool       candel;
+            /** Hands over the Value of this state which becomes Void.
+              * @return the Value
+              */
+            Value releaseValue();
 
         private:
 
-            std::string  name;
-
-            ValueState(const ValueState&); // forbid this
-            ValueState& operator= (const ValueState&);
+            Value        value;
+            MemberName   mem_name;
+            std::size_t  members;
         };
 
+        friend class ValueState;
+
     protected:
 
-        /** Helper class to represent the data of the current parsing step
-          * when the xml element is a Struct.
+        /** Gets a pointer to the topmost ValueState.
+          * @return pointer to ValueState
           */
-        class  MemberState : public ValueState
-        {
-        public:
-
-            /** Constructs a MemberState.
-              * @param  st   the actual state
-              * @param  val  pointer to the resulting value
-              */
-            MemberState(unsigned st, Value *val);
-
-            /** Transfers a Value into the ValueState.
-              * @param  val   the value
-              * @param  candel: @li true:  value is unique here, delete at end
-              *                 @li false: value is shared here, delete it somewhere else
-              */
-            virtual void takeValue(Value *val, bool candel = true);
+        virtual ValueState *getTopValueState() const = 0;
 
-            /** Transfers a member name into the MemberState.
-              * @param  name   the member name
-              */
-            virtual void takeName(const std::string &name);
+        /** Creates an empty Array, from the arena if enabled.
+          * @return the new Value
+          */
+        Value createArray();
 
-        protected:
+        /** Creates an empty Struct, from the arena if enabled.
+          * @return the new Value
+          */
+        Value createStruct();
 
-            Value  *mem_val;
+        /** Creates a Struct from the members collected last, from the arena if enabled.
+          * The Struct is sized once, so adding the members does not reallocate.
+          * @param  num  the number of members to take over
+          * @return the new Value
+          */
+        Value createStruct(std::size_t num);
 
-        private:
-            MemberState(const MemberState&); // forbid this
-            MemberState& operator= (const MemberState&);
-        };
+        /** Gets the interned form of a member name.
+          * The names seen last are cached by the parser, so a repeated
+          * name does not take the lock of the process wide name table.
+          * @param  name  the name as parsed
+          * @return the interned name
+          */
+        const MemberName &getMemberName(const std::string &name);
 
+        /** Collects the completed member of a Struct until the Struct is complete.
+          * A member without name or value is dropped.
+          * @param  member   the state of the \c member element
+          * @return true if the member was collected
+          */
+        bool collectMember(ValueState &member);
 
-        /** Helper class to represent the data of the current parsing step
-          * when the xml element is an Array.
+        /** Creates an RpcString, from the arena if enabled.
+          * @param  s  the content in UTF8
+          * @return the new Value
           */
-        class  ArrayState : public ValueState
-        {
-        public:
+        Value createString(const std::string &s);
 
-            /** Constructs an ArrayState.
-              * @param  st   the actual state
-              */
-            ArrayState(unsigned st);
+        /** Creates a Base64, from the arena if enabled.
+          * @param  s  the already encoded content
+          * @return the new Value
+          */
+        Value createBase64(const std::string &s);
 
-            /** Transfers a Value into the ValueState.
-              * @param  val   the value
-              * @param  candel: @li true:  value is unique here, delete at end
-              *                 @li false: value is shared here, delete it somewhere else
-              */
-            virtual void takeValue(Value *val, bool candel = true);
+        /** Creates a DateTime, from the arena if enabled.
+          * @param  s  the content as string
+          * @return the new Value
+          */
+        Value createDateTime(const std::string &s);
 
-        private:
-            ArrayState(const ArrayState&); // forbid this
-            ArrayState& operator= (const ArrayState&);
-        };
+    private:
 
-        friend class ValueState;
+        enum { NameCacheSize = 64 };
 
-    protected:
+        ValueArena                                 *arena;
+        std::vector<std::pair<MemberName, Value> >  members;  // of the open Structs, innermost last
+        MemberName                                  names[NameCacheSize];
 
-        /** Gets a pointer to the topmost ValueState.
-          * @return pointer to ValueState
-          */
-        virtual ValueState *getTopValueState() const = 0;
+        ValueParserBase(const ValueParserBase&); // forbid this
+        ValueParserBase& operator= (const ValueParserBase&);
     };
 
 
@@ -33,6 +33,7 @@
 #include <cstring>
 
 #include <ulxmlrpcpp/ulxr_xmlparse.h>
+#include <ulxmlrpcpp/ulxr_pullparse.h>
 #include <ulxmlrpcpp/ulxr_except.h>
 
 
@@ -40,11 +41,120 @@ namespace ulxr {
 
 
     XmlParser::XmlParser()
-        : ExpatWrapper()
+        : ExpatWrapper(false)
+        , pull(0)
     {
     }
 
 
+    XmlParser::~XmlParser()
+    {
+        delete pull;
+    }
+
+
+    void XmlParser::useNativeParser(bool enable)
+    {
+        if (enable && pull == 0)
+            pull = new PullParser;
+
+        else if (!enable)
+        {
+            delete pull;
+            pull = 0;
+        }
+    }
+
+
+    bool XmlParser::isNativeParserUsed() const
+    {
+        return pull != 0;
+    }
+
+
+    int XmlParser::parse(const char* buffer, int len, int isFinal)
+    {
+        if (pull == 0)
+            return ExpatWrapper::parse(buffer, len, isFinal);
+
+        static const XML_Char *no_atts[] = { 0 };
+        pull->feed(buffer, len, isFinal);
+        for (;;)
+        {
+            switch (pull->next())
+            {
+            case PullParser::eStartTag:
+                startElement(pull->getName(), no_atts);
+                break;
+
+            case PullParser::eEndTag:
+                endElement(pull->getName());
+                break;
+
+            case PullParser::eText:
+            {
+                const std::string_view text = pull->getText();
+                charData(text.data(), text.length());
+                break;
+            }
+
+            case PullParser::eNeedInput:
+            case PullParser::eEnd:
+                return 1;
+
+            case PullParser::eError:
+                return 0;
+            }
+        }
+    }
+
+
+    unsigned XmlParser::getErrorCode() const
+    {
+        if (pull == 0)
+            return ExpatWrapper::getErrorCode();
+
+        return pull->getError();
+    }
+
+
+    std::string XmlParser::getErrorString(unsigned code) const
+    {
+        if (pull == 0)
+            return ExpatWrapper::getErrorString(code);
+
+        return PullParser::getErrorString(code);
+    }
+
+
+    int XmlParser::getCurrentLineNumber() const
+    {
+        if (pull == 0)
+            return ExpatWrapper::getCurrentLineNumber();
+
+        return pull->getLineNumber();
+    }
+
+
+    int XmlParser::mapToFaultCode(int code) const
+    {
+        if (pull == 0)
+            return ExpatWrapper::mapToFaultCode(code);
+
+        switch (code)
+        {
+        case PullParser::eUnknownEncoding:
+            return UnsupportedEncodingError;
+
+        case PullParser::eBadCharRef:
+            return InvalidCharacterError;
+
+        default:
+            return NotWellformedError;
+        }
+    }
+
+
     void XmlParser::charData(const XML_Char *s, int len)
     {
         ULXR_TRACE("XmlParser::charData(const XML_Char*, int)"
@@ -54,7 +164,7 @@ namespace ulxr {
                                 << "<<"
                    */
                   );
-        states.top()->appendCharData(s, len);
+        appendCharData(s, len);
         ULXR_TRACE("XmlParser::charData(const XML_Char*, int) finished");
     }
 
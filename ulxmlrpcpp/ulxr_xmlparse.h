@@ -37,17 +37,67 @@
 namespace ulxr {
 
 
-    /** Base class for XML parsing with expat.
+    class PullParser;
+
+
+    /** Base class for XML parsing with expat or the native \c PullParser.
       * @ingroup grp_ulxr_parser
       */
     class  XmlParser : public ExpatWrapper
     {
     public:
 
-        /** Constructs a parser.
+        /** Constructs a parser which uses expat.
           */
         XmlParser();
 
+        /** Destroys the parser.
+          */
+        virtual ~XmlParser();
+
+        /** Selects the native \c PullParser instead of expat.
+          * It reads the subset of xml used by xml-rpc faster but rejects
+          * document type declarations and encodings other than UTF-8.
+          * Must be set before parsing starts.
+          * @param  enable  true: use the native parser
+          */
+        void useNativeParser(bool enable);
+
+        /** Tests if the native \c PullParser is used.
+          * @return true if the native parser is used
+          */
+        bool isNativeParserUsed() const;
+
+        /** Parse a pice of xml data.
+          * @param buffer   pointer start of next data chunk
+          * @param len      len of this chunk
+          * @param isFinal  true: last call to parser
+          * @return error condition, 0 = error
+          */
+        virtual int parse(const char* buffer, int len, int isFinal);
+
+        /** Gets the code for the current error.
+         * @return error code
+         */
+        virtual unsigned getErrorCode() const;
+
+        /** Gets the description for an error code
+          * @param code  error code
+          * @return  pointer to description
+          */
+        virtual std::string getErrorString(unsigned code) const;
+
+        /** Gets the line number in the xml data.
+          * @return  line number
+          */
+        virtual int getCurrentLineNumber() const;
+
+        /** Maps the parser error codes to xml-rpc error codes.
+          * @param  code   error code from the parser
+          * @return  the according xml-rpc error
+          */
+        virtual int mapToFaultCode(int code) const;
+
     protected:
 
         /** Checks if current and expected tag are the same.
@@ -82,6 +132,11 @@ namespace ulxr {
           * @param  len valid len.
           */
         virtual void charData(const XML_Char *s, int len);
+
+        XmlParser(const XmlParser&);   // forbid this
+        XmlParser& operator= (const XmlParser&);
+
+        PullParser  *pull;
     };
 
 
@@ -47,15 +47,33 @@ namespace ulxr {
     }
 
 
-    void XmlParserBase::clearStates()
+    void XmlParserBase::appendCharData(const XML_Char *s, int len)
     {
-        while (!states.empty())
-        {
-            delete states.top();
-            states.pop();
-        }
+        ULXR_TRACE("XmlParserBase::appendCharData(const XML_Char *, int)");
+        cdata.append(s, len);
+    }
+
+
+    std::size_t XmlParserBase::getCharDataEnd() const
+    {
+        return cdata.length();
+    }
+
+
+    const std::string &XmlParserBase::getCharData(const ParserState &state)
+    {
+        ULXR_TRACE("XmlParserBase::getCharData()");
+        chardata.assign(cdata, state.getCharDataStart(), std::string::npos);
+        return chardata;
     }
 
+
+    void XmlParserBase::releaseCharData(const ParserState &state)
+    {
+        cdata.resize(state.getCharDataStart());
+    }
+
+
     bool XmlParserBase::isComplete() const
     {
         return complete;
@@ -71,14 +89,10 @@ namespace ulxr {
 //////////////////////////////////////////////////////////////////////////
 //
 
-    XmlParserBase::ParserState::ParserState (unsigned st)
+    XmlParserBase::ParserState::ParserState (unsigned st, std::size_t start)
         : state(st)
         , prevstate(eUnknown)
-    {
-    }
-
-
-    XmlParserBase::ParserState::~ParserState()
+        , cdata_start(start)
     {
     }
 
@@ -107,23 +121,9 @@ namespace ulxr {
     }
 
 
-    void XmlParserBase::ParserState::appendCharData(const std::string &/*s*/)
-    {
-        ULXR_TRACE("XmlParserBase::ParserState::appendCharData(const std::string &)");
-    }
-
-
-    void XmlParserBase::ParserState::appendCharData(const XML_Char *s, int len)
-    {
-        ULXR_TRACE("XmlParserBase::ParserState::appendCharData(const XML_Char *, int)");
-        cdata.append(s, len);
-    }
-
-
-    std::string XmlParserBase::ParserState::getCharData() const
+    std::size_t XmlParserBase::ParserState::getCharDataStart() const
     {
-        ULXR_TRACE("XmlParserBase::ParserState::getCharData()");
-        return cdata;
+        return cdata_start;
     }
 
 
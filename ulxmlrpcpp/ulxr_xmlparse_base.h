@@ -35,7 +35,8 @@
 #define XMLPARSEAPI
 #include <ulxmlrpcpp/ulxmlrpcpp.h>
 
-#include <stack>
+#include <cstddef>
+#include <string>
 
 
 namespace ulxr {
@@ -53,7 +54,7 @@ namespace ulxr {
         XmlParserBase();
 
         /** Destroys the parser.
-          * The derived class is responsible for cleaning up stack<ParserState*>.
+          * The derived class is responsible for cleaning up its stack of states.
           */
         virtual ~XmlParserBase();
 
@@ -108,19 +109,19 @@ namespace ulxr {
         };
 
         /** Helper class to represent the data of the current parsing step.
+          * The states are plain frames which are reused for the elements of
+          * one document after another. The character data is not kept here
+          * but in the parser, a state only knows where its own data starts.
           */
         class  ParserState
         {
         public:
 
             /** Constructs a ParserState.
-              * @param  st  the actual ParserState
+              * @param  st           the actual ParserState
+              * @param  cdata_start  the position of the character data in the parser
               */
-            ParserState (unsigned st);
-
-            /** Destroys the ParserState.
-              */
-            virtual ~ParserState();
+            ParserState (unsigned st = eNone, std::size_t cdata_start = 0);
 
             /** Gets the ParserState of this ParserState
               * @return the actual ParserState
@@ -141,48 +142,51 @@ namespace ulxr {
               * Useful only for debugging.
               * @return the name of actual ParserState
               */
-            virtual std::string getStateName() const;
-
-            /** Appends some characters of the ParserState.
-              * This is a part of the data of an xml rpc element.
-              * @param  s   the current chunk of text
-              * @param  len valid len.
-              */
-            void appendCharData(const XML_Char *s, int len);
-
-            /** Appends some characters of the ParserState.
-              * This is a part of the data of an xml rpc element.
-              * @param  s   the current chunk of text
-              */
-            void appendCharData(const std::string &s);
+            std::string getStateName() const;
 
-            /** Gets the characters of the ParserState.
-              * @return  the data element
+            /** Gets the position of the character data of this ParserState.
+              * @return offset in the character data of the parser
               */
-            std::string getCharData() const;
+            std::size_t getCharDataStart() const;
 
         private:
 
-            ParserState(const ParserState&); // forbid this
-            ParserState& operator= (const ParserState&);
-
-            std::string  cdata;
-            unsigned   state;
-            unsigned   prevstate;
+            unsigned     state;
+            unsigned     prevstate;
+            std::size_t  cdata_start;
         };
 
     protected:
 
-        /** Removes all states from the state stack.
+        /** Appends some characters to the topmost ParserState.
+          * This is a part of the data of an xml rpc element.
+          * @param  s   the current chunk of text
+          * @param  len valid len.
           */
-        void clearStates();
+        void appendCharData(const XML_Char *s, int len);
 
-    protected:
+        /** Gets the position where the character data of a new ParserState starts.
+          * @return the offset
+          */
+        std::size_t getCharDataEnd() const;
 
-        std::stack<ParserState*>  states;
+        /** Gets the characters of the topmost ParserState.
+          * The string is reused and valid until the next call.
+          * @param  state   the topmost state
+          * @return  the data element
+          */
+        const std::string &getCharData(const ParserState &state);
+
+        /** Discards the characters of the topmost ParserState
+          * when it is removed from the stack.
+          * @param  state   the topmost state
+          */
+        void releaseCharData(const ParserState &state);
 
     private:
 
+        std::string  cdata;     // the text of all open elements, one after another
+        std::string  chardata;  // holds the text of the current element
         bool complete;
     };
 
@@ -0,0 +1,165 @@
+/***************************************************************************
+            ulxr_xmlsink.cpp  -  output for generated xml
+                             -------------------
+    begin                : Sat Oct 17 2026
+    copyright            : (C) 2026 by the ulxmlrpcpp developers
+
+    $Id$
+
+ ***************************************************************************/
+
+/**************************************************************************
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ *
+ ***************************************************************************/
+
+
+
+
+#include <ulxmlrpcpp/ulxmlrpcpp.h>
+
+#include <limits>
+
+#include <ulxmlrpcpp/ulxr_xmlsink.h>
+#include <ulxmlrpcpp/ulxr_value.h>
+#include <ulxmlrpcpp/ulxr_connection.h>
+
+
+namespace ulxr {
+
+
+    XmlWriterOptions::XmlWriterOptions()
+        : pretty(isXmlPrettyPrint())
+        , doubleFormat(Double::getFormat())
+        , escaping(EscapeAll)
+        , declaration(true)
+    {
+    }
+
+
+    XmlWriterOptions XmlWriterOptions::withPrettyPrint(bool in_pretty) const
+    {
+        XmlWriterOptions options(*this);
+        options.pretty = in_pretty;
+        return options;
+    }
+
+
+    XmlWriterOptions XmlWriterOptions::withDoubleFormat(DoubleFormat format) const
+    {
+        XmlWriterOptions options(*this);
+        options.doubleFormat = format;
+        return options;
+    }
+
+
+    XmlWriterOptions XmlWriterOptions::withEscaping(XmlEscaping in_escaping) const
+    {
+        XmlWriterOptions options(*this);
+        options.escaping = in_escaping;
+        return options;
+    }
+
+
+    XmlWriterOptions XmlWriterOptions::withXmlDeclaration(bool in_declaration) const
+    {
+        XmlWriterOptions options(*this);
+        options.declaration = in_declaration;
+        return options;
+    }
+
+
+//////////////////////////////////////////////////////
+
+
+    XmlSink::XmlSink(std::string &buf, const XmlWriterOptions &opts)
+        : buffer(buf)
+        , limit(std::numeric_limits<std::size_t>::max())
+        , options(opts)
+    {
+    }
+
+
+    XmlSink::XmlSink(std::string &buf, std::size_t lim, const XmlWriterOptions &opts)
+        : buffer(buf)
+        , limit(lim)
+        , options(opts)
+    {
+    }
+
+
+    XmlSink::~XmlSink()
+    {
+    }
+
+
+    void XmlSink::flush()
+    {
+    }
+
+
+    void XmlSink::overflow()
+    {
+    }
+
+
+//////////////////////////////////////////////////////
+
+
+    ConnectionSink::ConnectionSink(Connection *c, const XmlWriterOptions &opts, std::size_t chunk_size)
+        : XmlSink(chunk, chunk_size, opts)
+        , conn(c)
+    {
+        chunk.reserve(chunk_size);
+    }
+
+
+    ConnectionSink::~ConnectionSink()
+    {
+    }
+
+
+    void ConnectionSink::setPrefix(const std::string &in_prefix)
+    {
+        prefix = in_prefix;
+    }
+
+
+    void ConnectionSink::flush()
+    {
+        overflow();
+    }
+
+
+    void ConnectionSink::overflow()
+    {
+        if (!prefix.empty())
+        {
+            iovec pieces[2];
+            pieces[0].iov_base = const_cast<char*>(prefix.data());
+            pieces[0].iov_len = prefix.length();
+            pieces[1].iov_base = const_cast<char*>(chunk.data());
+            pieces[1].iov_len = chunk.length();
+            conn->write(pieces, 2);
+            prefix.clear();
+        }
+        else if (!chunk.empty())
+            conn->write(chunk.data(), chunk.length());
+        chunk.clear();
+    }
+
+
+}  // namespace ulxr
@@ -0,0 +1,313 @@
+/***************************************************************************
+            ulxr_xmlsink.h  -  output for generated xml
+                             -------------------
+    begin                : Sat Oct 17 2026
+    copyright            : (C) 2026 by the ulxmlrpcpp developers
+
+    $Id$
+
+ ***************************************************************************/
+
+/**************************************************************************
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ *
+ ***************************************************************************/
+
+#ifndef ULXR_XMLSINK_H
+#define ULXR_XMLSINK_H
+
+#include <ulxmlrpcpp/ulxmlrpcpp.h>
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+
+namespace ulxr {
+
+
+    class Connection;
+
+
+    /** Settings for the generation of xml.
+      * The options are immutable, the \c with...() methods return a modified
+      * copy. Default options take the process wide settings from
+      * \c isXmlPrettyPrint() and \c Double::getFormat() once, so xml which is
+      * generated with an options object reads no global state and several
+      * documents with different settings can be generated concurrently.
+      */
+    class  XmlWriterOptions
+    {
+    public:
+
+        /** The text format of double values.
+          */
+        enum DoubleFormat
+        {
+            FixedFormat,       //!< digits and six decimals like 1234567.890123
+            ScientificFormat,  //!< six significant digits and an exponent like 1.23457e+06
+            ShortestFormat     //!< the fewest digits which read back exactly like 1234567.8901234
+        };
+
+        /** Constructs the options from the current process wide settings.
+          * Strings are escaped with \c EscapeAll and calls and responses start
+          * with an xml declaration.
+          */
+        XmlWriterOptions();
+
+        /** Returns a copy with a different pretty-print setting.
+          * @param  pretty   true: add spaces and linefeeds for better readability
+          * @return the modified options
+          */
+        XmlWriterOptions withPrettyPrint(bool pretty) const;
+
+        /** Returns a copy with a different format for doubles.
+          * @param  format   the new format
+          * @return the modified options
+          */
+        XmlWriterOptions withDoubleFormat(DoubleFormat format) const;
+
+        /** Returns a copy with a different escaping of strings.
+          * @param  escaping   the characters to replace in strings
+          * @return the modified options
+          */
+        XmlWriterOptions withEscaping(XmlEscaping escaping) const;
+
+        /** Returns a copy which adds or omits the xml declaration.
+          * @param  declaration   true: calls and responses start with <?xml ...?>
+          * @return the modified options
+          */
+        XmlWriterOptions withXmlDeclaration(bool declaration) const;
+
+        /** Determines if spaces and linefeeds are added.
+          * @return true if pretty-print is enabled
+          */
+        bool isPrettyPrint() const
+        {
+            return pretty;
+        }
+
+        /** Returns the text format of double values.
+          * @return the format
+          */
+        DoubleFormat getDoubleFormat() const
+        {
+            return doubleFormat;
+        }
+
+        /** Returns the characters which are replaced in strings.
+          * @return the escaping
+          */
+        XmlEscaping getEscaping() const
+        {
+            return escaping;
+        }
+
+        /** Determines if calls and responses start with an xml declaration.
+          * @return true if the declaration is added
+          */
+        bool hasXmlDeclaration() const
+        {
+            return declaration;
+        }
+
+        /** Returns the number of characters of an indentation.
+          * @param  indent   number of spaces to indent
+          * @return number of characters
+          */
+        std::size_t getIndentSize(unsigned indent) const
+        {
+            return pretty ? indent : 0;
+        }
+
+        /** Returns the number of characters of a line feed.
+          * @return number of characters
+          */
+        std::size_t getLinefeedSize() const
+        {
+            return pretty ? 1 : 0;
+        }
+
+    private:
+
+        bool          pretty;
+        DoubleFormat  doubleFormat;
+        XmlEscaping   escaping;
+        bool          declaration;
+    };
+
+
+    /** Output for generated xml.
+      * Values, calls and responses append their xml to a sink instead of
+      * returning it piece by piece in temporary strings, so a whole tree
+      * is written into one growing buffer.
+      * The buffer is supplied by the caller and may be reused for several
+      * documents to keep its capacity.
+      * The \c XmlWriterOptions are fixed when the sink is constructed,
+      * so a document is never mixed up if the process wide settings are
+      * switched meanwhile and compact output does no indentation work.
+      */
+    class  XmlSink
+    {
+    public:
+
+        /** Constructs a sink which appends to a string.
+          * @param  buffer    receives the xml, existing content is kept
+          * @param  options   settings for the generated xml
+          */
+        explicit XmlSink(std::string &buffer, const XmlWriterOptions &options = XmlWriterOptions());
+
+        /** Destroys the sink.
+          */
+        virtual ~XmlSink();
+
+        /** Appends some text.
+          * @param  s   the text
+          */
+        void append(std::string_view s)
+        {
+            buffer.append(s.data(), s.size());
+            if (buffer.size() >= limit)
+                overflow();
+        }
+
+        /** Appends a single character.
+          * @param  c   the character
+          */
+        void append(char c)
+        {
+            buffer += c;
+            if (buffer.size() >= limit)
+                overflow();
+        }
+
+        /** Appends some text after replacing dangerous sequences.
+          * @param  s   the text, see \c xmlEscape()
+          */
+        void appendEscaped(std::string_view s)
+        {
+            xmlEscape(s, buffer, options.getEscaping());
+            if (buffer.size() >= limit)
+                overflow();
+        }
+
+        /** Appends the spaces for an indentation if pretty-print is enabled.
+          * @param  indent   number of spaces to indent
+          */
+        void appendIndent(unsigned indent)
+        {
+            if (options.isPrettyPrint())
+                buffer.append(indent, ' ');
+        }
+
+        /** Appends a line feed if pretty-print is enabled.
+          */
+        void appendLinefeed()
+        {
+            if (options.isPrettyPrint())
+                append('\n');
+        }
+
+        /** Returns the settings for the generated xml.
+          * @return the options
+          */
+        const XmlWriterOptions &getOptions() const
+        {
+            return options;
+        }
+
+        /** Passes on everything appended so far.
+          * A sink which only appends to a string has nothing to do.
+          */
+        virtual void flush();
+
+    protected:
+
+        /** Constructs a sink which passes on its content in parts.
+          * @param  buffer   holds the content until it is passed on
+          * @param  limit    size of the buffer which causes \c overflow()
+          * @param  options  settings for the generated xml
+          */
+        XmlSink(std::string &buffer, std::size_t limit, const XmlWriterOptions &options);
+
+        /** Called when the buffer has reached its limit.
+          */
+        virtual void overflow();
+
+        std::string  &buffer;
+
+    private:
+
+        XmlSink(const XmlSink&);                // forbid this
+        XmlSink& operator=(const XmlSink&);
+
+        std::size_t       limit;
+        XmlWriterOptions  options;
+    };
+
+
+    /** A sink which writes the xml directly to a connection.
+      * The xml is written in parts of a fixed size, so the complete
+      * document never exists in memory. \c flush() must be called
+      * after the document is complete to write the last part.
+      * A prefix like a http header is written together with the
+      * first part in one vectored write.
+      */
+    class  ConnectionSink : public XmlSink
+    {
+    public:
+
+        /** Constructs the sink.
+          * @param  conn         the connection to write to
+          * @param  options      settings for the generated xml
+          * @param  chunk_size   number of bytes to collect before writing
+          */
+        explicit ConnectionSink(Connection *conn,
+                                const XmlWriterOptions &options = XmlWriterOptions(),
+                                std::size_t chunk_size = 64 * 1024);
+
+        /** Destroys the sink. Content which was not flushed is discarded.
+          */
+        virtual ~ConnectionSink();
+
+        /** Sets data which precedes the xml on the connection.
+          * It is held back and leaves together with the first part.
+          * @param  prefix   the data, usually a protocol header
+          */
+        void setPrefix(const std::string &prefix);
+
+        /** Writes the remaining content to the connection.
+          */
+        virtual void flush();
+
+    protected:
+
+        /** Writes the collected content to the connection.
+          */
+        virtual void overflow();
+
+    private:
+
+        Connection   *conn;
+        std::string   chunk;
+        std::string   prefix;
+    };
+
+
+}  // namespace ulxr
+
+
+#endif // ULXR_XMLSINK_H